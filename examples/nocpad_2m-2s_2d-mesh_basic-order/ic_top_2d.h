@@ -107,7 +107,7 @@ public:
   
   // --- NoC Channels ---
   // REQ Router + In/Out Channels
-  router_wh_top< 4+2, 4+2, rreq_flit_t, 5, DIM_X>   rtr_req[DIM_X][DIM_Y];
+  router_wh_top< 4+2, 4+2, rreq_flit_t, 5, DIM_X, 1, arbiter<4+2, MATRIX>, true>   rtr_req[DIM_X][DIM_Y];
   
   Connections::Combinational<wreq_flit_t>    chan_hor_right_req[DIM_X+1][DIM_Y];
   Connections::Combinational<wreq_flit_t>    chan_hor_left_req[DIM_X+1][DIM_Y];
@@ -122,7 +122,7 @@ public:
   
   
   // RESP Router + In/Out Channels
-  router_wh_top< 4+2, 4+2, rresp_flit_t, 5, DIM_X>  *rtr_resp[DIM_X][DIM_Y];
+  router_wh_top< 4+2, 4+2, rresp_flit_t, 5, DIM_X, 1, arbiter<4+2, MATRIX>, true>  *rtr_resp[DIM_X][DIM_Y];
   
   Connections::Combinational<rreq_flit_t>    chan_hor_right_resp[DIM_X+1][DIM_Y];
   Connections::Combinational<rreq_flit_t>    chan_hor_left_resp[DIM_X+1][DIM_Y];
@@ -246,7 +246,7 @@ public:
     // Resp/Bck Router
     for(int row=0; row<DIM_Y; ++row) {
       for (int col=0; col<DIM_X; ++col) {
-        rtr_resp[col][row] = new router_wh_top< 4+2, 4+2, rresp_flit_t, 5, DIM_X> (sc_gen_unique_name("Router-resp"));
+        rtr_resp[col][row] = new router_wh_top< 4+2, 4+2, rresp_flit_t, 5, DIM_X, 1, arbiter<4+2, MATRIX>, true> (sc_gen_unique_name("Router-resp"));
         rtr_resp[col][row]->clk(clk);
         rtr_resp[col][row]->rst_n(rst_n);
         rtr_resp[col][row]->route_lut[0](route_lut[0][0]);
@@ -86,8 +86,9 @@ public:
   
   //--- Internals ---//
   // --- Master/Slave IFs ---
-  axi_master_if < smpl_cfg > *master_if[smpl_cfg::MASTER_NUM];
-  axi_slave_if  < smpl_cfg > *slave_if[smpl_cfg::SLAVE_NUM];
+  // The interfaces source route the packets with their XY routes
+  axi_master_if < smpl_cfg, sr_xy_merge<DIM_X> > *master_if[smpl_cfg::MASTER_NUM];
+  axi_slave_if  < smpl_cfg, sr_xy_merge<DIM_X> > *slave_if[smpl_cfg::SLAVE_NUM];
   
   // Master IF Channels
   // Read Req/Resp
@@ -107,7 +108,7 @@ public:
   
   // --- NoC Channels ---
   // REQ Router + In/Out Channels
-  router_wh_top< 4+2, 4+2, rreq_flit_t, 5, DIM_X>   rtr_req[DIM_X][DIM_Y];
+  router_wh_top< 4+2, 4+2, rreq_flit_t, 11, DIM_X>   rtr_req[DIM_X][DIM_Y];
   
   Connections::Combinational<wreq_flit_t>    chan_hor_right_req[DIM_X+1][DIM_Y];
   Connections::Combinational<wreq_flit_t>    chan_hor_left_req[DIM_X+1][DIM_Y];
@@ -122,7 +123,7 @@ public:
   
   
   // RESP Router + In/Out Channels
-  router_wh_top< 4+2, 4+2, rresp_flit_t, 5, DIM_X>  *rtr_resp[DIM_X][DIM_Y];
+  router_wh_top< 4+2, 4+2, rresp_flit_t, 11, DIM_X>  *rtr_resp[DIM_X][DIM_Y];
   
   Connections::Combinational<rreq_flit_t>    chan_hor_right_resp[DIM_X+1][DIM_Y];
   Connections::Combinational<rreq_flit_t>    chan_hor_left_resp[DIM_X+1][DIM_Y];
@@ -151,7 +152,7 @@ public:
       unsigned col = j % DIM_X; // aka x dim
       unsigned row = j / DIM_X; // aka y dim
       
-      slave_if[j] = new axi_slave_if < smpl_cfg > (sc_gen_unique_name("Slave-if"));
+      slave_if[j] = new axi_slave_if < smpl_cfg, sr_xy_merge<DIM_X> > (sc_gen_unique_name("Slave-if"));
       slave_if[j]->clk(clk);
       slave_if[j]->rst_n(rst_n);
       
@@ -181,7 +182,7 @@ public:
       unsigned col = (smpl_cfg::SLAVE_NUM + i) % DIM_X; // aka x dim
       unsigned row = (smpl_cfg::SLAVE_NUM + i) / DIM_X; // aka y dim
       
-      master_if[i] = new axi_master_if < smpl_cfg > (sc_gen_unique_name("Master-if"));
+      master_if[i] = new axi_master_if < smpl_cfg, sr_xy_merge<DIM_X> > (sc_gen_unique_name("Master-if"));
       master_if[i]->clk(clk);
       master_if[i]->rst_n(rst_n);
       // Pass the address Map
@@ -246,7 +247,7 @@ public:
     // Resp/Bck Router
     for(int row=0; row<DIM_Y; ++row) {
       for (int col=0; col<DIM_X; ++col) {
-        rtr_resp[col][row] = new router_wh_top< 4+2, 4+2, rresp_flit_t, 5, DIM_X> (sc_gen_unique_name("Router-resp"));
+        rtr_resp[col][row] = new router_wh_top< 4+2, 4+2, rresp_flit_t, 11, DIM_X> (sc_gen_unique_name("Router-resp"));
         rtr_resp[col][row]->clk(clk);
         rtr_resp[col][row]->rst_n(rst_n);
         rtr_resp[col][row]->route_lut[0](route_lut[0][0]);
@@ -34,8 +34,8 @@ struct cfg {
   static const unsigned char VCS  = VCS_;
 };
 
-// the used configuration. 2 Masters/Slaves, 64bit AXI, 2.4.4.1 phit flits
-typedef cfg<2, 2, 8, 8, 4, 4, 4, 4, 1, 2> smpl_cfg;
+// the used configuration. 2 Masters/Slaves, 64bit AXI, 2.4.4.1 phit flits, 4 VCs
+typedef cfg<2, 2, 8, 8, 4, 4, 4, 4, 1, 4> smpl_cfg;
 
 SC_MODULE(ic_top) {
 public:
@@ -48,7 +48,7 @@ public:
   typedef flit_dnp<smpl_cfg::WREQ_PHITS>  wreq_flit_t;
   typedef flit_dnp<smpl_cfg::WRESP_PHITS> wresp_flit_t;
     
-  typedef sc_uint<1> cr_t;
+  typedef sc_uint< nvhls::log2_ceil<smpl_cfg::VCS>::val > cr_t;
     
   static const unsigned DIM_X = 2;
   static const unsigned DIM_Y = 2;
@@ -172,7 +172,9 @@ public:
   
   // --- NoC Channels ---
   // REQ Router + In/Out Channels
-  rtr_vc< 4+2, 4+2, rreq_flit_t, DIM_X, 1, 2, 3, 5>   rtr_inst[DIM_X][DIM_Y];
+  // Requests (VC 0/2) and Responses (VC 1/3) form 2 VC classes. Each hop allocates the VC of the class by the
+  //   destination, while outputs 4/5 eject to the interfaces on VC 0/1
+  rtr_vc< 4+2, 4+2, rreq_flit_t, DIM_X, 1, smpl_cfg::VCS, 3, 5, MATRIX, 2, VA_DST, 4>   rtr_inst[DIM_X][DIM_Y];
   
   Connections::Combinational<rreq_flit_t>    chan_hor_right_data[DIM_X+1][DIM_Y];
   Connections::Combinational<cr_t>           chan_hor_right_cr[DIM_X+1][DIM_Y];
@@ -0,0 +1,133 @@
+#ifndef SYNTH_TOP_IC_H
+#define SYNTH_TOP_IC_H
+
+#pragma once
+
+#include "../../src/router_wh.h"
+#include "../../src/rt_table.h"
+
+#include "systemc.h"
+#include "nvhls_connections.h"
+
+#pragma hls_design top
+
+#if DNP_NODE_W < 6
+  #error "An 8x8 mesh needs DNP_NODE_W of at least 6"
+#endif
+
+// Routing of the mesh routers. 4: LUT, 5: XY, 7: West-First adaptive, 8: Odd-Even adaptive
+//   With LUT routing every router has a runtime programmable routing table, loaded by the testbench through
+//   rt_cfg_in. Its updates return at rt_cfg_out after passing every table. All packets eject at port 4.
+#ifndef BENCH_RC
+  #define BENCH_RC 5
+#endif
+
+// 1: Age based arbitration of the routers, where older packets win, instead of plain MATRIX arbitration
+#ifndef BENCH_AGE
+  #define BENCH_AGE 0
+#endif
+
+// An 8x8 2-D mesh of wormhole routers, where every router connects a node through two injection/ejection ports.
+//   Nodes inject synthetic traffic directly as flits, thus the network is evaluated without the AXI interfaces.
+//   The 64 nodes need 6 bit node IDs, thus the example is built with DNP_NODE_W=6.
+//   Node n sits at column n%DIM_X and row n/DIM_X. RD packets eject at port 4 and WR packets at port 5.
+SC_MODULE(ic_top) {
+public:
+  typedef flit_dnp<2> flit_t;
+
+  static const unsigned DIM_X = 8;
+  static const unsigned DIM_Y = 8;
+  static const unsigned NODES = DIM_X*DIM_Y;
+  static const unsigned LUT_NODES = (BENCH_RC==4) ? NODES : 1;
+
+  sc_in_clk    clk;
+  sc_in <bool> rst_n;
+
+  // Node side channels. [0]: RD, [1]: WR
+  Connections::In<flit_t>   inj_in[NODES][2];
+  Connections::Out<flit_t>  ej_out[NODES][2];
+
+#if BENCH_RC==4
+  // Routing table configuration chain
+  Connections::In<rt_cfg_t>   rt_cfg_in;
+  Connections::Out<rt_cfg_t>  rt_cfg_out;
+#endif
+
+  //--- Internals ---//
+  sc_signal< sc_uint<dnp::D_W> >  route_lut[1];
+
+  sc_signal< sc_uint<dnp::D_W> > rtr_id_x[DIM_X];
+  sc_signal< sc_uint<dnp::D_W> > rtr_id_y[DIM_Y];
+
+  router_wh_top< 4+2, 4+2, flit_t, BENCH_RC, DIM_X, LUT_NODES, arbiter<4+2, MATRIX>, false, false, BENCH_AGE>  rtr[DIM_X][DIM_Y];
+
+#if BENCH_RC==4
+  // The table of router (x,y) has the ID of its node, and the chain follows the node IDs
+  sc_signal< sc_uint<rt_cfg_t::ID_W> >  rt_id[NODES];
+  sc_signal< sc_uint<dnp::D_W> >        rt_lut[NODES][NODES];
+  rt_table<NODES>                       *rt_tbl[NODES];
+  Connections::Combinational<rt_cfg_t>  chan_rt_cfg[NODES-1];
+#endif
+
+  Connections::Combinational<flit_t>    chan_hor_right[DIM_X+1][DIM_Y];
+  Connections::Combinational<flit_t>    chan_hor_left[DIM_X+1][DIM_Y];
+  Connections::Combinational<flit_t>    chan_ver_up[DIM_X][DIM_Y+1];
+  Connections::Combinational<flit_t>    chan_ver_down[DIM_X][DIM_Y+1];
+
+  SC_CTOR(ic_top) {
+    route_lut[0] = 0;
+
+    for (int row=0; row<DIM_Y; ++row) rtr_id_y[row] = row;
+    for (int col=0; col<DIM_X; ++col) rtr_id_x[col] = col;
+
+    for(int row=0; row<DIM_Y; ++row) {
+      for (int col=0; col<DIM_X; ++col) {
+        unsigned node = row*DIM_X + col;
+
+        rtr[col][row].clk(clk);
+        rtr[col][row].rst_n(rst_n);
+#if BENCH_RC==4
+        rt_id[node] = node;
+        rt_tbl[node] = new rt_table<NODES>(sc_gen_unique_name("rt_table"));
+        rt_tbl[node]->clk(clk);
+        rt_tbl[node]->rst_n(rst_n);
+        rt_tbl[node]->RT_ID(rt_id[node]);
+        if (node==0)       rt_tbl[node]->cfg_in(rt_cfg_in);
+        else               rt_tbl[node]->cfg_in(chan_rt_cfg[node-1]);
+        if (node==NODES-1) rt_tbl[node]->cfg_out(rt_cfg_out);
+        else               rt_tbl[node]->cfg_out(chan_rt_cfg[node]);
+
+        for (unsigned n=0; n<NODES; ++n) {
+          rt_tbl[node]->route_lut[n](rt_lut[node][n]);
+          rtr[col][row].route_lut[n](rt_lut[node][n]);
+        }
+#else
+        rtr[col][row].route_lut[0](route_lut[0]);
+#endif
+        rtr[col][row].id_x(rtr_id_x[col]);
+        rtr[col][row].id_y(rtr_id_y[row]);
+
+        rtr[col][row].data_in[0](chan_hor_right[col][row]);
+        rtr[col][row].data_out[0](chan_hor_left[col][row]);
+
+        rtr[col][row].data_in[1](chan_hor_left[col+1][row]);
+        rtr[col][row].data_out[1](chan_hor_right[col+1][row]);
+
+        rtr[col][row].data_in[2](chan_ver_up[col][row]);
+        rtr[col][row].data_out[2](chan_ver_down[col][row]);
+
+        rtr[col][row].data_in[3](chan_ver_down[col][row+1]);
+        rtr[col][row].data_out[3](chan_ver_up[col][row+1]);
+
+        rtr[col][row].data_in[4](inj_in[node][0]);
+        rtr[col][row].data_out[4](ej_out[node][0]);
+
+        rtr[col][row].data_in[5](inj_in[node][1]);
+        rtr[col][row].data_out[5](ej_out[node][1]);
+      }
+    }
+  }; // End of constructor
+
+}; // End of SC_MODULE
+
+#endif // SYNTH_TOP_IC_H
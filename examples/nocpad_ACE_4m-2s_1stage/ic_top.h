@@ -42,14 +42,14 @@ struct cfg {
 
 // the used configuration.1 Home, 2 Full ACE Masters, 2 ACE-Lite Masters, 2 Slaves
 typedef cfg<1, 4, 0, 2,
-            (ace::ace5<axi::cfg::ace>::C_CACHE_WIDTH >> 3), //bits to bytes
-            (ace::ace5<axi::cfg::ace>::C_CACHE_WIDTH >> 3), //bits to bytes
-            (ace::ace5<axi::cfg::ace>::C_CACHE_WIDTH < 64) ? 4 : (ace::ace5<axi::cfg::ace>::C_CACHE_WIDTH >> 4), //bits to phits
-            (ace::ace5<axi::cfg::ace>::C_CACHE_WIDTH < 64) ? 4 : (ace::ace5<axi::cfg::ace>::C_CACHE_WIDTH >> 4), //bits to phits
-            (ace::ace5<axi::cfg::ace>::C_CACHE_WIDTH < 64) ? 4 : (ace::ace5<axi::cfg::ace>::C_CACHE_WIDTH >> 4), //bits to phits
+            (ace::ace5<axi::cfg::ace>::C_DATA_CHAN_WIDTH >> 3), //bits to bytes
+            (ace::ace5<axi::cfg::ace>::C_DATA_CHAN_WIDTH >> 3), //bits to bytes
+            (ace::ace5<axi::cfg::ace>::C_DATA_CHAN_WIDTH < 64) ? 4 : (ace::ace5<axi::cfg::ace>::C_DATA_CHAN_WIDTH >> 4), //bits to phits
+            (ace::ace5<axi::cfg::ace>::C_DATA_CHAN_WIDTH < 64) ? 4 : (ace::ace5<axi::cfg::ace>::C_DATA_CHAN_WIDTH >> 4), //bits to phits
+            (ace::ace5<axi::cfg::ace>::C_DATA_CHAN_WIDTH < 64) ? 4 : (ace::ace5<axi::cfg::ace>::C_DATA_CHAN_WIDTH >> 4), //bits to phits
             1,
             3,
-            (ace::ace5<axi::cfg::ace>::C_CACHE_WIDTH < 64) ? 4 : (ace::ace5<axi::cfg::ace>::C_CACHE_WIDTH >> 4) //bits to phits
+            (ace::ace5<axi::cfg::ace>::C_DATA_CHAN_WIDTH < 64) ? 4 : (ace::ace5<axi::cfg::ace>::C_DATA_CHAN_WIDTH >> 4) //bits to phits
            > smpl_cfg;
 
 SC_MODULE(ic_top) {
@@ -107,7 +107,10 @@ public:
   ace_master_if     < smpl_cfg > *master_if[smpl_cfg::FULL_MASTER_NUM];
   acelite_master_if < smpl_cfg > *master_lite_if[smpl_cfg::LITE_MASTER_NUM];
   ace_slave_if      < smpl_cfg > *slave_if[smpl_cfg::SLAVE_NUM];
-  ace_home          < smpl_cfg > *home[smpl_cfg::HOME_NUM];
+  // HOME multicasts its Snoops, forked by the Snoop request router. Slaves respond directly to the initiators,
+  //   while ReadOnce/ReadShared/ReadClean read the Memory speculatively
+  typedef ace_home  < smpl_cfg, 4, 0, 4, smpl_cfg::FULL_MASTER_NUM, true, false, true, true > home_t;
+  home_t                         *home[smpl_cfg::HOME_NUM];
   
   // NoC Channels
   // READ Fwd Req, master+home -> slaves+home
@@ -118,13 +121,14 @@ public:
   Connections::Combinational<rreq_flit_t>                                     chan_rd_req_r2h[smpl_cfg::HOME_NUM]; // M-IF_to_Rtr
   Connections::Combinational<rreq_flit_t>                                     chan_rd_req_h2r[smpl_cfg::HOME_NUM];  // Rtr_to_S-IF
   
-  // READ Bck Resp, slaves+home -> home+masters
+  // READ Bck Resp, slaves+home+full masters(Direct Cache Transfer) -> home+masters
   sc_signal<sc_uint<dnp::D_W> > route_rd_resp[NODES];
-  router_wh_top<smpl_cfg::SLAVE_NUM+smpl_cfg::HOME_NUM, smpl_cfg::ALL_MASTER_NUM+smpl_cfg::HOME_NUM, rresp_flit_t, 4, 0, NODES>  INIT_S1(rtr_rd_resp);
+  router_wh_top<smpl_cfg::SLAVE_NUM+smpl_cfg::HOME_NUM+smpl_cfg::FULL_MASTER_NUM, smpl_cfg::ALL_MASTER_NUM+smpl_cfg::HOME_NUM, rresp_flit_t, 4, 0, NODES>  INIT_S1(rtr_rd_resp);
   Connections::Combinational<rresp_flit_t>                                    chan_rd_s2r[smpl_cfg::SLAVE_NUM];  // S-IF_to_Rtr
   Connections::Combinational<rresp_flit_t>                                    chan_rd_r2m[smpl_cfg::ALL_MASTER_NUM]; // Rtr_to_M-IF
   Connections::Combinational<rresp_flit_t>                                    chan_rd_resp_r2h[smpl_cfg::HOME_NUM]; // M-IF_to_Rtr
   Connections::Combinational<rresp_flit_t>                                    chan_rd_resp_h2r[smpl_cfg::HOME_NUM];  // Rtr_to_S-IF
+  Connections::Combinational<rresp_flit_t>                                    chan_rd_dct_m2r[smpl_cfg::FULL_MASTER_NUM]; // M-IF_to_Rtr
   
   // WRITE fwd Req, Router+In/Out Channels
   sc_signal<sc_uint<dnp::D_W> > route_wr_req[NODES];
@@ -144,7 +148,7 @@ public:
   
   // CACHE fwd Req, Router+In/Out Channels
   sc_signal<sc_uint<dnp::D_W> > route_cache_req[NODES];
-  router_wh_top<smpl_cfg::HOME_NUM, smpl_cfg::FULL_MASTER_NUM, creq_flit_t, 4, 0, NODES>   INIT_S1(rtr_cache_req);
+  router_wh_top<smpl_cfg::HOME_NUM, smpl_cfg::FULL_MASTER_NUM, creq_flit_t, 6, 0, NODES>   INIT_S1(rtr_cache_req);
   Connections::Combinational<creq_flit_t>                                    chan_creq_h2r[smpl_cfg::HOME_NUM];  // Home_to_Rtr
   Connections::Combinational<creq_flit_t>                                    chan_creq_r2m[smpl_cfg::FULL_MASTER_NUM]; // Rtr_to_M-IF
   
@@ -235,6 +239,7 @@ public:
       // Cache-NoC
       master_if[i]->cache_flit_in(chan_creq_r2m[i]);
       master_if[i]->cache_flit_out(chan_cresp_m2r[i]);
+      master_if[i]->dct_flit_out(chan_rd_dct_m2r[i]);
     }
       
       // Connect ACE LITE Master-IFs to the appropriate channels
@@ -270,7 +275,7 @@ public:
     // --- HOME-NODE(s) --- //
     // ---------------------//
     for (unsigned i=0; i<smpl_cfg::HOME_NUM; ++i) {
-      home[i] = new ace_home < smpl_cfg > (sc_gen_unique_name("Home-Node"));
+      home[i] = new home_t (sc_gen_unique_name("Home-Node"));
       home[i]->clk(clk);
       home[i]->rst_n(rst_n);
   
@@ -343,6 +348,7 @@ public:
     // In from Slaves
     for(int i=0; i<smpl_cfg::SLAVE_NUM; ++i)  rtr_rd_resp.data_in[i](chan_rd_s2r[i]);
     for(int i=0; i<smpl_cfg::HOME_NUM; ++i)   rtr_rd_resp.data_in[smpl_cfg::SLAVE_NUM+i](chan_rd_resp_h2r[i]);
+    for(int i=0; i<smpl_cfg::FULL_MASTER_NUM; ++i) rtr_rd_resp.data_in[smpl_cfg::SLAVE_NUM+smpl_cfg::HOME_NUM+i](chan_rd_dct_m2r[i]);
     // Out to Master
     for(int i=0; i<smpl_cfg::ALL_MASTER_NUM; ++i) rtr_rd_resp.data_out[i](chan_rd_r2m[i]);
     for(int i=0; i<smpl_cfg::HOME_NUM; ++i)       rtr_rd_resp.data_out[smpl_cfg::ALL_MASTER_NUM+i](chan_rd_resp_r2h[i]);
@@ -0,0 +1,62 @@
+#ifndef WGT_TOP_IC_H
+#define WGT_TOP_IC_H
+
+#pragma once
+
+#include "../../src/router_wh.h"
+
+#include "systemc.h"
+#include "nvhls_connections.h"
+
+#pragma hls_design top
+
+// Weighted arbitration of the router. WEIGHTED_RR or DEFICIT_RR
+#ifndef BENCH_ARB
+  #define BENCH_ARB WEIGHTED_RR
+#endif
+
+// A single wormhole router, where IN_NUM inputs compete for one output. The router has runtime weights (WGT),
+//   thus its inputs share the output's bandwidth by the weights at arb_weight.
+SC_MODULE(ic_top) {
+public:
+  typedef flit_dnp<2> flit_t;
+
+  static const unsigned IN_NUM = 3;
+
+  sc_in_clk    clk;
+  sc_in <bool> rst_n;
+
+  sc_in< sc_uint<8> >       arb_weight[IN_NUM];
+
+  Connections::In<flit_t>   inj_in[IN_NUM];
+  Connections::Out<flit_t>  ej_out;
+
+  //--- Internals ---//
+  sc_signal< sc_uint<dnp::D_W> >  route_lut[1];
+  sc_signal< sc_uint<dnp::D_W> >  rtr_id_x;
+  sc_signal< sc_uint<dnp::D_W> >  rtr_id_y;
+
+  // Constant RC, every packet leaves from output 0
+  router_wh_top< IN_NUM, 1, flit_t, 1, 0, 1, arbiter<IN_NUM, BENCH_ARB>, false, false, false, true>  rtr;
+
+  SC_CTOR(ic_top) : rtr("rtr") {
+    route_lut[0] = 0;
+    rtr_id_x     = 0;
+    rtr_id_y     = 0;
+
+    rtr.clk(clk);
+    rtr.rst_n(rst_n);
+    rtr.route_lut[0](route_lut[0]);
+    rtr.id_x(rtr_id_x);
+    rtr.id_y(rtr_id_y);
+
+    for (unsigned ip=0; ip<IN_NUM; ++ip) {
+      rtr.arb_weight[ip](arb_weight[ip]);
+      rtr.data_in[ip](inj_in[ip]);
+    }
+    rtr.data_out[0](ej_out);
+  }; // End of constructor
+
+}; // End of SC_MODULE
+
+#endif // WGT_TOP_IC_H
@@ -11,261 +11,1207 @@
 #include "../include/ace.h"
 #include "../include/flit_ace.h"
 #include "../include/duth_fun.h"
+#include "../include/addr_dec.h"
+#include "../include/fifo_queue_oh.h"
+
+#ifndef __SYNTHESIS__
+#include <map>
+#include <deque>
+#endif
+
+// --- Helping Data structures --- //
+// Transaction table entry, kept by the admission stage.
+struct home_table_entry {
+  bool                                   valid;
+  bool                                   is_read;
+  bool                                   wait_ack;  // Response sent, waiting the ACK of a Full master
+  sc_uint<dnp::S_W>                      initiator;
+  sc_uint<dnp::ace::ID_W>                tid;
+  sc_uint<dnp::ace::AH_W+dnp::ace::AL_W> line;      // Cache line address
+  sc_uint<3>                             pending;   // Events to wait for, until the entry retires
+  sc_uint<dnp::ace::HID_W+1>             ack_seq;   // Order of the response towards the initiator
+  bool                                   inval;     // Back-invalidation of a line evicted from the Snoop filter
+  bool                                   sf_track;  // The line is tracked by the Snoop filter entry at sf_way
+  sc_uint<4>                             sf_way;
+  bool                                   direct;    // The response may bypass HOME (DCT/DMT)
+};
+
+// Info passed from admission to snoop collection for every new transaction.
+template <typename rreq_flit_t, typename wreq_flit_t, unsigned LINE_FLITS>
+struct home_trans_info {
+  sc_uint<dnp::ace::HID_W> tag;
+  sc_uint<dnp::S_W+1>      snp_cnt;   // Number of Snoop responses to gather
+  bool                     inval;     // Back-invalidation. Only dirty data are written back, no response is sent
+  bool                     dct;       // Direct Cache Transfer got requested from the snooped master
+  bool                     dmt;       // A Memory read is forwarded for Direct Memory Transfer
+  bool                     spec;      // Memory is read speculatively, in parallel to the Snoops
+  rreq_flit_t              req;       // The initial request
+  wreq_flit_t              wdata[LINE_FLITS]; // The data flits of a write request
+  sc_uint<8>               wdata_cnt;
+
+  inline friend std::ostream& operator << ( std::ostream& os, const home_trans_info& info ) {
+    os <<"Tag: "<< info.tag <<", Snoops: "<< info.snp_cnt <<", Inval: "<< info.inval <<", DCT: "<< info.dct <<", DMT: "<< info.dmt <<", Spec: "<< info.spec <<", Req: "<< info.req;
+    return os;
+  }
+
+#ifdef SYSTEMC_INCLUDED
+  // Only for SystemC
+  inline friend void sc_trace(sc_trace_file* tf, const home_trans_info& info, const std::string& name) {
+    sc_trace(tf, info.tag,     name + ".tag");
+    sc_trace(tf, info.snp_cnt, name + ".snp_cnt");
+    sc_trace(tf, info.inval,   name + ".inval");
+    sc_trace(tf, info.dct,     name + ".dct");
+    sc_trace(tf, info.dmt,     name + ".dmt");
+    sc_trace(tf, info.spec,    name + ".spec");
+    sc_trace(tf, info.req,     name + ".req");
+    for (unsigned i=0; i<LINE_FLITS; ++i) sc_trace(tf, info.wdata[i], name + ".wdata_" + std::to_string(i));
+    sc_trace(tf, info.wdata_cnt, name + ".wdata_cnt");
+  }
+#endif
+};
+
+// Outcome of the Snoop gathering, passed back to admission.
+struct home_gather_upd {
+  sc_uint<dnp::ace::HID_W> tag;
+  bool                     wb;       // A write-back has been issued
+  sc_uint<dnp::MCAST_W>    retained; // The snooped Full masters that keep a copy of the line (IsShared)
+
+  inline friend std::ostream& operator << ( std::ostream& os, const home_gather_upd& upd ) {
+    os <<"Tag: "<< upd.tag <<", WB: "<< upd.wb <<", Retained: "<< upd.retained;
+    return os;
+  }
+
+#ifdef SYSTEMC_INCLUDED
+  // Only for SystemC
+  inline friend void sc_trace(sc_trace_file* tf, const home_gather_upd& upd, const std::string& name) {
+    sc_trace(tf, upd.tag,      name + ".tag");
+    sc_trace(tf, upd.wb,       name + ".wb");
+    sc_trace(tf, upd.retained, name + ".retained");
+  }
+#endif
+};
+
+// Read response job. Either a complete response, or one that waits for the data from Memory.
+template <typename rresp_flit_t, unsigned LINE_FLITS>
+struct home_rd_job {
+  sc_uint<dnp::ace::HID_W>    tag;
+  sc_uint<dnp::D_W>           mem;      // The slave that serves the request when from_mem
+  bool                        from_mem;
+  bool                        direct;   // The snooped master or the Slave respond directly to the initiator
+  bool                        spec_rd;  // A speculative Memory read is in flight. Its data are used only when from_mem
+  bool                        spec_issue; // Registers a speculative Memory read to the Slave's order
+  sc_uint<dnp::ace::C_RESP_W> resp;     // Accumulated Snoop responses
+  rresp_flit_t                head;     // Response header towards the initiator
+  rresp_flit_t                data[LINE_FLITS]; // Response data, when not from_mem
+  sc_uint<8>                  data_cnt;
+
+  inline friend std::ostream& operator << ( std::ostream& os, const home_rd_job& job ) {
+    os <<"Tag: "<< job.tag <<", Mem: "<< job.mem <<", FromMem: "<< job.from_mem <<", Direct: "<< job.direct <<", Spec: "<< job.spec_rd <<"/"<< job.spec_issue <<", Resp: "<< job.resp;
+    return os;
+  }
+
+#ifdef SYSTEMC_INCLUDED
+  // Only for SystemC
+  inline friend void sc_trace(sc_trace_file* tf, const home_rd_job& job, const std::string& name) {
+    sc_trace(tf, job.tag,      name + ".tag");
+    sc_trace(tf, job.mem,      name + ".mem");
+    sc_trace(tf, job.from_mem, name + ".from_mem");
+    sc_trace(tf, job.direct,   name + ".direct");
+    sc_trace(tf, job.spec_rd,  name + ".spec_rd");
+    sc_trace(tf, job.spec_issue, name + ".spec_issue");
+    sc_trace(tf, job.resp,     name + ".resp");
+    sc_trace(tf, job.head,     name + ".head");
+    for (unsigned i=0; i<LINE_FLITS; ++i) sc_trace(tf, job.data[i], name + ".data_" + std::to_string(i));
+    sc_trace(tf, job.data_cnt, name + ".data_cnt");
+  }
+#endif
+};
+
+// Write job. Informs about the writes of a transaction that a slave will respond to.
+struct home_wr_job {
+  sc_uint<dnp::ace::HID_W> tag;
+  sc_uint<dnp::D_W>        mem;
+  sc_uint<dnp::S_W>        initiator;
+  bool                     wb;       // Dirty data are written back. The response is consumed by HOME
+  bool                     wr;       // The initiator's write. The response is forwarded to the initiator
+
+  inline friend std::ostream& operator << ( std::ostream& os, const home_wr_job& job ) {
+    os <<"Tag: "<< job.tag <<", Mem: "<< job.mem <<", Init: "<< job.initiator <<", WB: "<< job.wb <<", WR: "<< job.wr;
+    return os;
+  }
+
+#ifdef SYSTEMC_INCLUDED
+  // Only for SystemC
+  inline friend void sc_trace(sc_trace_file* tf, const home_wr_job& job, const std::string& name) {
+    sc_trace(tf, job.tag,       name + ".tag");
+    sc_trace(tf, job.mem,       name + ".mem");
+    sc_trace(tf, job.initiator, name + ".initiator");
+    sc_trace(tf, job.wb,        name + ".wb");
+    sc_trace(tf, job.wr,        name + ".wr");
+  }
+#endif
+};
+
+#ifndef __SYNTHESIS__
+// The initiators of the Snoops that the HOMEs send, per cache line in their order. The snooped masters see
+//   only the AC channel, whose PROT is the initiator's, thus the testbench resolves the initiator of each
+//   Snoop bundle here. A line is served by a single HOME, one transaction at a time.
+inline std::map<unsigned long long, std::deque<unsigned> >& ace_home_snoop_inits() {
+  static std::map<unsigned long long, std::deque<unsigned> > snoop_inits;
+  return snoop_inits;
+};
+#endif
 
 // --- HOME NODE ---
 // All coherent transactions are serialized to a HOME NODE.
 // HOME generates the apropriate Snoop requests and gathers their responses
 // Regarding the responses of the snooped masters, HOME decides if access to
 //   a main memory (i.e. Slave) is required for the transaction completion
-template <typename cfg>
+// Up to TRANS_NUM transactions are in flight, each one occupying a slot of the transaction table.
+//   The slot number tags the Snoop requests, thus their responses may arrive in any order.
+//   Transactions are serialized only when they target the same cache line, or when they share
+//   initiator, direction and AXI ID, to preserve AXI ordering. HOME comprises 4 parallel stages:
+//   - req_admit    : Admits requests, sends the Snoops, gathers ACKs and retires the transactions
+//   - snoop_gather : Gathers the Snoop responses, and issues write-backs and Memory accesses
+//   - rd_resp_job  : Sends Read responses, either snooped data or data from Memory
+//   - wr_resp_job  : Sinks write-back responses and forwards Write responses
+//   A Slave responds in order, thus responses are matched to transactions by per Slave queues.
+// An optional inclusive Snoop filter (SF_SETS>0) tracks which Full masters may hold each line.
+//   SF_SETS x SF_WAYS entries keep a presence vector of SF_PV_W bits, each bit covering
+//   ceil(FULL_MASTER_NUM/SF_PV_W) masters. Only the masters marked present get snooped, while a miss
+//   goes straight to Memory. Masters evict silently, thus bits are cleared only by Snoop responses
+//   that do not retain the line. Replacing a valid entry issues a back-invalidation, which snoops
+//   the sharers with CleanInvalid and writes back any dirty data. With SF_SETS=0 Snoops are broadcast.
+// With SNP_MCAST a single Snoop flit carries all its destinations as a mask, and the Snoop request
+//   routers (RC_METHOD 6) fork it. Otherwise a unicast flit is pushed per snooped master.
+// With DCT (Direct Cache Transfer) a Read that expects data and snoops a single master, carries the
+//   initiator and its request in the Snoop (CREQ_PHITS>3). On a hit, the snooped master sends the Read response
+//   straight to the initiator through the Read response NoC, and HOME only gathers the Snoop response.
+//   Dirty data are sent directly only when the request accepts them, otherwise they return to HOME for
+//   the write-back.
+// With DMT (Direct Memory Transfer) a Read that no cache served, is forwarded to the Slave with the initiator
+//   and the coherence bits of the response (RREQ_PHITS>3). The Slave responds straight to the initiator.
+// A direct response is ordered to other responses of its initiator only by its ACK, thus while it is
+//   in flight no other Read of the initiator is admitted, and vice versa.
+// With SPEC_RD, ReadOnce/ReadShared/ReadClean read the Memory in parallel to the Snoops. The Memory data
+//   are buffered until the Snoops conclude, and get dropped when a cache supplies the line. The slot
+//   retires only after the speculative read returns. Wasted speculative reads are reported.
+template <typename cfg, unsigned TRANS_NUM=4, unsigned SF_SETS=0, unsigned SF_WAYS=4, unsigned SF_PV_W=cfg::FULL_MASTER_NUM,
+          bool SNP_MCAST=false, bool DCT=false, bool DMT=false, bool SPEC_RD=false>
 SC_MODULE(ace_home) {
   typedef typename ace::ace5<axi::cfg::ace> ace5_;
   typedef typename ace::ACE_Encoding        enc_;
-  
+
   typedef flit_dnp<cfg::RREQ_PHITS>  rreq_flit_t;
   typedef flit_dnp<cfg::RRESP_PHITS> rresp_flit_t;
   typedef flit_dnp<cfg::WREQ_PHITS>  wreq_flit_t;
   typedef flit_dnp<cfg::WRESP_PHITS> wresp_flit_t;
   typedef flit_dnp<cfg::CREQ_PHITS>  creq_flit_t;
   typedef flit_dnp<cfg::CRESP_PHITS> cresp_flit_t;
-  
+
   typedef flit_ack ack_flit_t;
-  
+
   typedef sc_uint< clog2<cfg::RRESP_PHITS>::val > cnt_phit_rresp_t;
   typedef sc_uint< clog2<cfg::WRESP_PHITS>::val > cnt_phit_wresp_t;
-  
+
+  typedef sc_uint<dnp::ace::HID_W>   tag_t;
+  typedef sc_uint<dnp::ace::HID_W+1> tag_flag_t; // Tag with a flag at the MSB
+
+  // A cache line streams as a flit per Snoop Data beat. Read and write data flits carry a beat as well.
+  static const unsigned LINE_FLITS      = ace5_::C_LINE_BEATS;
+  static const unsigned LOG_FLIT_BYTES  = nvhls::log2_ceil<(ace5_::C_DATA_CHAN_WIDTH>>3)>::val;
+
+  typedef home_trans_info<rreq_flit_t, wreq_flit_t, LINE_FLITS> trans_info_t;
+  typedef home_rd_job<rresp_flit_t, LINE_FLITS>                 rd_job_t;
+
   const unsigned char LOG_RD_M_LANES = nvhls::log2_ceil<cfg::RD_LANES>::val;
   const unsigned char LOG_WR_M_LANES = nvhls::log2_ceil<cfg::WR_LANES>::val;
-  
+
+  static const unsigned LOG_LINE_BYTES = nvhls::log2_ceil<(ace5_::C_CACHE_WIDTH>>3)>::val;
+
+  // Snoop filter dimensions. Arrays keep a single entry when the filter is disabled
+  static const bool     SF_EN       = (SF_SETS>0);
+  static const unsigned SF_SETS_N   = SF_EN ? SF_SETS : 1;
+  static const unsigned SF_WAYS_N   = SF_EN ? SF_WAYS : 1;
+  static const unsigned SF_PV_N     = (SF_PV_W>0) ? SF_PV_W : 1;
+  static const unsigned SF_GRP      = (cfg::FULL_MASTER_NUM+SF_PV_N-1)/SF_PV_N; // Masters per presence bit
+  static const unsigned LOG_SF_SETS = nvhls::log2_ceil<SF_SETS_N>::val;
+
+  typedef sc_uint<dnp::ace::AH_W+dnp::ace::AL_W> line_t;
+  typedef sc_uint<dnp::MCAST_W>                  master_mask_t; // One bit per Full master
+  typedef sc_uint<SF_PV_N>                       sf_pv_t;
+
   sc_in_clk    clk;
   sc_in <bool> rst_n;
-  
+
   sc_in < sc_uint<(dnp::ace::AH_W+dnp::ace::AL_W)> > addr_map[cfg::SLAVE_NUM][2];
-  
+
   sc_in< sc_uint<dnp::S_W> > THIS_ID;
-  
+
   // NoC Side Channels
   Connections::Out<creq_flit_t> INIT_S1(cache_req);
   Connections::In<cresp_flit_t> INIT_S1(cache_resp);
-  
+
   Connections::In<rreq_flit_t>   INIT_S1(rd_from_master);
   Connections::Out<rresp_flit_t> INIT_S1(rd_to_master);
-  
+
   Connections::Out<rreq_flit_t> INIT_S1(rd_to_slave);
   Connections::In<rresp_flit_t> INIT_S1(rd_from_slave);
-  
+
   Connections::In<wreq_flit_t> INIT_S1(wr_from_master);
   Connections::Out<wresp_flit_t> INIT_S1(wr_to_master);
-  
+
   Connections::Out<wreq_flit_t> INIT_S1(wr_to_slave);
   Connections::In<wresp_flit_t> INIT_S1(wr_from_slave);
-  
+
   Connections::In<ack_flit_t> INIT_S1(ack_from_master);
 
-  
+  // --- Internals --- //
+  // FIFOs that pass the transactions between the stages
+  sc_fifo<trans_info_t> INIT_S1(trans_info);  // Admit   -> Gather
+  sc_fifo<rd_job_t>     INIT_S1(rd_jobs);     // Gather  -> RD resp
+  sc_fifo<home_wr_job>  INIT_S1(wr_jobs);     // Gather  -> WR resp
+
+  // FIFOs that inform the admission stage about progress. The MSB flags...
+  sc_fifo<home_gather_upd> INIT_S1(gather_upd);  // Gather  -> Admit | Snoops gathered
+  sc_fifo<tag_flag_t>   INIT_S1(rd_upd);      // RD resp -> Admit | ...a speculative read returned, else response sent
+  sc_fifo<tag_flag_t>   INIT_S1(wr_upd);      // WR resp -> Admit | ...a write-back completed, else response sent
+
+  // Placed on admission
+  home_table_entry trans_table[TRANS_NUM];
+  sc_uint<dnp::ace::HID_W+1> resp_cnt[cfg::FULL_MASTER_NUM][2]; // Responses sent per Full master and RD/WR
+  sc_uint<dnp::ace::HID_W+1> ack_cnt[cfg::FULL_MASTER_NUM][2];  // ACKs received per Full master and RD/WR
+
+  // Snoop filter, placed on admission
+  bool          sf_valid[SF_SETS_N][SF_WAYS_N];
+  bool          sf_busy[SF_SETS_N][SF_WAYS_N];  // A transaction on the tracked line is in flight
+  line_t        sf_tag[SF_SETS_N][SF_WAYS_N];
+  sf_pv_t       sf_pv[SF_SETS_N][SF_WAYS_N];
+  sc_uint<4>    sf_victim[SF_SETS_N];           // Round-Robin replacement
+
+#ifndef __SYNTHESIS__
+  // Snoop filter statistics
+  unsigned long long sf_hits, sf_misses, sf_back_invals;
+  unsigned long long snoops_sent, snoops_bcast; // Snoops sent, and those a broadcast would send
+  unsigned long long dct_reqs, dct_hits;        // Direct Cache Transfers requested, and served by the snooped master
+  unsigned long long dmt_reads;                 // Direct Memory Transfers
+  unsigned long long spec_reads, spec_wasted;   // Speculative Memory reads, and those dropped as a cache supplied the line
+#endif
+
+  // Placed on Snoop gathering
+  trans_info_t                trans_pend[TRANS_NUM];
+  bool                        trans_pend_valid[TRANS_NUM];
+  sc_uint<dnp::S_W+1>         resp_wait[TRANS_NUM];
+  sc_uint<dnp::ace::C_RESP_W> resp_accum[TRANS_NUM];
+  master_mask_t               retained[TRANS_NUM];
+  bool                        got_data[TRANS_NUM];
+  bool                        got_dirty[TRANS_NUM];
+  bool                        got_fwd[TRANS_NUM];   // Data got sent directly to the initiator
+  cresp_flit_t                snoop_resp_data[TRANS_NUM][LINE_FLITS];
+
+  // Placed on RD response
+  rd_job_t                      rd_pend[TRANS_NUM];
+  bool                          spec_on[TRANS_NUM];   // A speculative read is in flight
+  bool                          spec_ret[TRANS_NUM];  // ...its data returned and are buffered
+  bool                          spec_res[TRANS_NUM];  // ...the Snoops concluded
+  bool                          spec_use[TRANS_NUM];  // ...and its data form the response
+  rresp_flit_t                  spec_data[TRANS_NUM][LINE_FLITS];
+  sc_uint<8>                    spec_cnt[TRANS_NUM];
+  fifo_queue<tag_t, TRANS_NUM>  rd_order[cfg::SLAVE_NUM];
+
+  // Placed on WR response
+  home_wr_job                   wr_pend[TRANS_NUM];
+  fifo_queue<tag_t, TRANS_NUM>  wr_order[cfg::SLAVE_NUM];
+
   // Constructor
   SC_HAS_PROCESS(ace_home);
   ace_home(sc_module_name name_="ace_home")
     :
-    sc_module (name_)
+    sc_module (name_),
+    trans_info (TRANS_NUM),
+    rd_jobs    (2*TRANS_NUM),
+    wr_jobs    (TRANS_NUM),
+    gather_upd (TRANS_NUM),
+    rd_upd     (2*TRANS_NUM),
+    wr_upd     (2*TRANS_NUM)
   {
-    SC_THREAD(req_check);
+    NVHLS_ASSERT_MSG((TRANS_NUM>0) && (TRANS_NUM<=(1<<dnp::ace::HID_W)) && (TRANS_NUM<=8), "HOME supports 1 to 8 outstanding transactions.");
+    NVHLS_ASSERT_MSG(!SF_EN || (((SF_SETS & (SF_SETS-1)) == 0) && (SF_WAYS>0) && (SF_WAYS<=16)), "Snoop filter sets must be a power of 2, ways 1 to 16.");
+    NVHLS_ASSERT_MSG((LINE_FLITS>0) && ((ace5_::C_DATA_CHAN_WIDTH>>4) == cfg::CRESP_PHITS) &&
+                     (cfg::CRESP_PHITS == cfg::RRESP_PHITS) && (cfg::CRESP_PHITS == cfg::WREQ_PHITS), "HOME expects a data beat per Snoop/Read/Write data flit.");
+    NVHLS_ASSERT_MSG(!SF_EN || (TRANS_NUM>1), "Snoop filter back-invalidations require 2 or more outstanding transactions.");
+    NVHLS_ASSERT_MSG(!SNP_MCAST || ((cfg::SLAVE_NUM+cfg::FULL_MASTER_NUM) <= dnp::ace::MC_W), "Snooped masters exceed the multicast mask.");
+    NVHLS_ASSERT_MSG(!DCT || (cfg::CREQ_PHITS > dnp::ace::creq::RQ_PHIT), "Direct Cache Transfer requires 4 Snoop request phits.");
+    NVHLS_ASSERT_MSG(!DCT || ((dnp::ace::creq::RQ_INIT_PTR + dnp::S_W) <= dnp::PHIT_W), "The DCT initiator exceeds the Snoop request phit.");
+    NVHLS_ASSERT_MSG(!DMT || (cfg::RREQ_PHITS > dnp::ace::req::DMT_PHIT), "Direct Memory Transfer requires 4 Read request phits.");
+
+    SC_THREAD(req_admit);
+    sensitive << clk.pos();
+    async_reset_signal_is(rst_n, false);
+
+    SC_THREAD(snoop_gather);
+    sensitive << clk.pos();
+    async_reset_signal_is(rst_n, false);
+
+    SC_THREAD(rd_resp_job);
+    sensitive << clk.pos();
+    async_reset_signal_is(rst_n, false);
+
+    SC_THREAD(wr_resp_job);
     sensitive << clk.pos();
     async_reset_signal_is(rst_n, false);
   }
-  
-  
-  void req_check () {
+
+  //-------------------------------------//
+  //--- Admission, Snoops and Retiring ---//
+  //-------------------------------------//
+  void req_admit () {
     cache_req.Reset();
-    cache_resp.Reset();
     rd_from_master.Reset();
-    rd_to_master.Reset();
-    rd_to_slave.Reset();
-    rd_from_slave.Reset();
-    
     wr_from_master.Reset();
-    wr_to_master.Reset();
-    wr_to_slave.Reset();
-    wr_from_slave.Reset();
-    
-    //-- End of Reset ---//
+    ack_from_master.Reset();
+
+    #pragma hls_unroll yes
+    for (int i=0; i<TRANS_NUM; ++i) {
+      trans_table[i].valid    = false;
+      trans_table[i].wait_ack = false;
+      trans_table[i].pending  = 0;
+      trans_table[i].sf_track = false;
+      trans_table[i].direct   = false;
+    }
+    #pragma hls_unroll yes
+    for (int i=0; i<cfg::FULL_MASTER_NUM; ++i) {
+      resp_cnt[i][0] = 0; resp_cnt[i][1] = 0;
+      ack_cnt[i][0]  = 0; ack_cnt[i][1]  = 0;
+    }
+    #pragma hls_unroll yes
+    for (int s=0; s<SF_SETS_N; ++s) {
+      sf_victim[s] = 0;
+      #pragma hls_unroll yes
+      for (int w=0; w<SF_WAYS_N; ++w) {
+        sf_valid[s][w] = false;
+        sf_busy[s][w]  = false;
+      }
+    }
+#ifndef __SYNTHESIS__
+    sf_hits = 0; sf_misses = 0; sf_back_invals = 0;
+    snoops_sent = 0; snoops_bcast = 0;
+    dct_reqs = 0; dct_hits = 0; dmt_reads = 0;
+    spec_reads = 0; spec_wasted = 0;
+#endif
 
+    bool        req_held = false; // A received request that waits for a free slot, or for a conflicting one to retire
+    rreq_flit_t held_req;
+    wreq_flit_t held_wdata[LINE_FLITS];
+    sc_uint<8>  held_wdata_cnt = 0;
+    bool        ack_held = false; // A received ACK, whose response has not yet been registered
+    ack_flit_t  held_ack;
+    bool        rd_prio  = false; // Alternates RD/WR requests
+    //-- End of Reset ---//
+    wait();
     while(1) {
+      // --- Progress of the in-flight transactions --- //
+      home_gather_upd g_upd;
+      if (gather_upd.nb_read(g_upd)) { // Snoops gathered. A write-back adds one more event to wait for.
+        tag_t tag = g_upd.tag;
+        if (!g_upd.wb) trans_table[tag].pending--;
+        // The line is present to the masters that retained it, and to a Full initiator
+        if (SF_EN && trans_table[tag].sf_track) {
+          sc_uint<LOG_SF_SETS+1> set = trans_table[tag].line & (SF_SETS_N-1);
+          sc_uint<4>             way = trans_table[tag].sf_way;
+          sf_pv_t new_pv = master_2_pv(g_upd.retained) | init_2_pv(trans_table[tag].initiator);
+          sf_pv[set][way]    = new_pv;
+          sf_valid[set][way] = (new_pv != 0);
+        }
+      }
+
+      tag_flag_t upd;
+
+      if (rd_upd.nb_read(upd)) {
+        tag_t tag = upd.range(dnp::ace::HID_W-1, 0);
+        if (upd[dnp::ace::HID_W]) trans_table[tag].pending--; // Speculative read returned
+        else                      resp_sent(tag);
+      }
+
+      if (wr_upd.nb_read(upd)) {
+        tag_t tag = upd.range(dnp::ace::HID_W-1, 0);
+        if (upd[dnp::ace::HID_W]) trans_table[tag].pending--; // Write-back completed
+        else                      resp_sent(tag);
+      }
+
+      // Only a Full Master responds with an Ack, in the order it received the responses
+      if (!ack_held) ack_held = ack_from_master.PopNB(held_ack);
+      if (ack_held) {
+        unsigned master = held_ack.get_src() - cfg::SLAVE_NUM;
+        bool     is_rd  = held_ack.is_rack();
+        bool     found  = false;
+        #pragma hls_unroll yes
+        for (int i=0; i<TRANS_NUM; ++i) {
+          if (!found && trans_table[i].valid && trans_table[i].wait_ack &&
+              (trans_table[i].initiator == held_ack.get_src()) && (trans_table[i].is_read == is_rd) &&
+              (trans_table[i].ack_seq == ack_cnt[master][is_rd]))
+          {
+            trans_table[i].wait_ack = false;
+            trans_table[i].pending--;
+            found = true;
+          }
+        }
+        if (found) {
+          ack_cnt[master][is_rd]++;
+          ack_held = false;
+          #ifndef __SYNTHESIS__
+          if(is_rd) std::cout << "[HOME "<< THIS_ID <<"] Got RD ACK from " << held_ack.get_src() << " @" << sc_time_stamp() << "\n";
+          else      std::cout << "[HOME "<< THIS_ID <<"] Got WR ACK from " << held_ack.get_src() << " @" << sc_time_stamp() << "\n";
+          #endif
+        }
+      }
+
+      // Retire the completed transactions
+      #pragma hls_unroll yes
+      for (int i=0; i<TRANS_NUM; ++i) {
+        if (trans_table[i].valid && (trans_table[i].pending == 0)) {
+          trans_table[i].valid = false;
+          if (SF_EN && trans_table[i].sf_track) sf_busy[trans_table[i].line & (SF_SETS_N-1)][trans_table[i].sf_way] = false;
+        }
+      }
+
+      // --- Admission of a new request --- //
+      if (!req_held) {
+        bool got_wr = false;
+        if (rd_prio) {
+          req_held = rd_from_master.PopNB(held_req);
+          if (!req_held) req_held = got_wr = wr_from_master.PopNB(held_req);
+        } else {
+          req_held = got_wr = wr_from_master.PopNB(held_req);
+          if (!req_held) req_held = rd_from_master.PopNB(held_req);
+        }
+        rd_prio = !rd_prio;
+        // Write data follow their header, up to a cache line
+        if (got_wr) {
+          held_wdata_cnt = 0;
+          bool got_tail  = false;
+          while (!got_tail) {
+            wreq_flit_t wdata_flit;
+            if (wr_from_master.PopNB(wdata_flit)) {
+              NVHLS_ASSERT_MSG(held_wdata_cnt<LINE_FLITS, "Coherent Write exceeds a cache line.");
+              held_wdata[held_wdata_cnt] = wdata_flit;
+              held_wdata_cnt++;
+              got_tail = wdata_flit.is_tail();
+            } else {
+              wait();
+            }
+          }
+        }
+      }
+
+      if (req_held) {
+        ace5_::AddrPayload cur_req;
+        held_req.get_rd_req(cur_req);
+        sc_uint<dnp::S_W> initiator = held_req.get_src();
+        bool is_read  = (held_req.get_type() == dnp::PACK_TYPE__RD_REQ);
+        bool is_write = (held_req.get_type() == dnp::PACK_TYPE__WR_REQ);
+        NVHLS_ASSERT_MSG(is_read ^ is_write , "ERROR : Home got request of wrong type.");
+        NVHLS_ASSERT_MSG(((held_req.data[0].to_uint() >> dnp::D_PTR) & ((1<<dnp::D_W)-1)) == (THIS_ID.read().to_uint()), "Flit misrouted!");
+
+        line_t line = (cur_req.addr.to_uint() >> LOG_LINE_BYTES);
+        // Depending the initiating master (Lite or Full Ace) different number of request/repsonses are expected
+        bool init_is_full = (initiator<(cfg::SLAVE_NUM+cfg::FULL_MASTER_NUM));
+
+        // Look for free slots and for conflicting in-flight transactions
+        bool  conflict  = false;
+        bool  rd_inflight = false; // A Read of the initiator is in flight, that a direct response may overtake
+        bool  got_free  = false;
+        bool  got_free2 = false; // A second slot, for a back-invalidation
+        tag_t tag       = 0;
+        tag_t tag_inv   = 0;
+        #pragma hls_unroll yes
+        for (int i=0; i<TRANS_NUM; ++i) {
+          if (trans_table[i].valid) {
+            bool same_line  = (trans_table[i].line == line);
+            bool same_order = (trans_table[i].initiator == initiator) && (trans_table[i].is_read == is_read) &&
+                              (trans_table[i].tid == cur_req.id.to_uint());
+            bool same_init  = (trans_table[i].initiator == initiator) && trans_table[i].is_read && is_read;
+            conflict    = conflict || same_line || same_order || (same_init && trans_table[i].direct);
+            rd_inflight = rd_inflight || same_init;
+          } else if (!got_free) {
+            got_free = true;
+            tag      = i;
+          } else if (!got_free2) {
+            got_free2 = true;
+            tag_inv   = i;
+          }
+        }
+
+        // Snoop filter lookup. On a miss a Full initiator allocates an entry, preferably an invalid one
+        sc_uint<LOG_SF_SETS+1> sf_set = line & (SF_SETS_N-1);
+        bool       sf_hit    = false;
+        sc_uint<4> hit_way   = 0;
+        bool       got_inv   = false;
+        sc_uint<4> inv_way   = 0;
+        bool       got_vict  = false;
+        sc_uint<4> vict_way  = 0;
+        #pragma hls_unroll yes
+        for (int w=0; w<SF_WAYS_N; ++w) {
+          if (sf_valid[sf_set][w] && (sf_tag[sf_set][w] == line)) {
+            sf_hit  = true;
+            hit_way = w;
+          }
+          if (!sf_valid[sf_set][w] && !sf_busy[sf_set][w] && !got_inv) {
+            got_inv = true;
+            inv_way = w;
+          }
+        }
+        #pragma hls_unroll yes
+        for (int i=0; i<SF_WAYS_N; ++i) {
+          unsigned w = (sf_victim[sf_set] + i) % SF_WAYS_N;
+          if (!sf_busy[sf_set][w] && !got_vict) {
+            got_vict = true;
+            vict_way = w;
+          }
+        }
+        bool       sf_alloc   = SF_EN && !sf_hit && init_is_full;
+        sc_uint<4> alloc_way  = got_inv ? inv_way : vict_way;
+        bool       need_inval = sf_alloc && !got_inv;
+        bool       sf_ready   = !sf_alloc || got_inv || (got_vict && got_free2);
+
+        if (got_free && !conflict && sf_ready) {
+          #ifndef __SYNTHESIS__
+          if(is_read) std::cout << "[HOME "<< THIS_ID <<"] Got RD from " << initiator << " : " << cur_req << " Tag: " << tag << " @" << sc_time_stamp() << "\n";
+          else        std::cout << "[HOME "<< THIS_ID <<"] Got WR from " << initiator << " : " << cur_req << " Tag: " << tag << " @" << sc_time_stamp() << "\n";
+          #endif
+
+          // Masters to snoop. All Full masters but the initiator, or those the Snoop filter marks present
+          sf_pv_t       sf_cur_pv = sf_hit ? sf_pv[sf_set][hit_way] : (sf_pv_t)0;
+          master_mask_t snp_mask  = 0;
+          #pragma hls_unroll yes
+          for (int m=0; m<cfg::FULL_MASTER_NUM; ++m) {
+            bool present = !SF_EN || sf_cur_pv[m/SF_GRP];
+            snp_mask[m]  = present && ((m+cfg::SLAVE_NUM) != initiator);
+          }
+          // A direct response waits for no other Read of the initiator. For DCT the single snooped master
+          //   is the only candidate data supplier
+          bool may_direct = (DCT || DMT) && is_read && req_expects_data(cur_req.snoop, true) && !rd_inflight;
+          bool use_dct    = DCT && may_direct && (mask_cnt(snp_mask) == 1);
+          // Speculation pays off only when a Snoop may miss. The Slave then serves the response through HOME
+          bool use_spec   = SPEC_RD && is_read && (snp_mask != 0) &&
+                            ((cur_req.snoop == enc_::ARSNOOP::RD_ONCE) || (cur_req.snoop == enc_::ARSNOOP::RD_SHARED) ||
+                             (cur_req.snoop == enc_::ARSNOOP::RD_CLEAN));
+
+          trans_table[tag].valid     = true;
+          trans_table[tag].is_read   = is_read;
+          trans_table[tag].wait_ack  = false;
+          trans_table[tag].initiator = initiator;
+          trans_table[tag].tid       = cur_req.id.to_uint();
+          trans_table[tag].line      = line;
+          trans_table[tag].pending   = (init_is_full ? 3 : 2) + use_spec; // Snoops gathered + Response sent + ACK + Speculative read
+          trans_table[tag].inval     = false;
+          trans_table[tag].sf_track  = SF_EN && (sf_hit || sf_alloc);
+          trans_table[tag].sf_way    = sf_hit ? hit_way : alloc_way;
+          trans_table[tag].direct    = may_direct;
+
+          if (need_inval) {
+            // The victim's sharers get invalidated by a HOME transaction, in parallel to the request
+            line_t        inv_line = sf_tag[sf_set][alloc_way];
+            master_mask_t inv_mask = pv_2_master(sf_pv[sf_set][alloc_way]);
+
+            trans_table[tag_inv].valid     = true;
+            trans_table[tag_inv].is_read   = true;
+            trans_table[tag_inv].wait_ack  = false;
+            trans_table[tag_inv].initiator = THIS_ID.read();
+            trans_table[tag_inv].tid       = 0;
+            trans_table[tag_inv].line      = inv_line;
+            trans_table[tag_inv].pending   = 1; // Snoops gathered
+            trans_table[tag_inv].inval     = true;
+            trans_table[tag_inv].sf_track  = false;
+            trans_table[tag_inv].direct    = false;
+
+            ace5_::AddrPayload inv_req;
+            inv_req.id    = 0;
+            inv_req.addr  = ((ace5_::Addr)inv_line) << LOG_LINE_BYTES;
+            inv_req.len   = LINE_FLITS-1;
+            inv_req.size  = LOG_FLIT_BYTES;
+            inv_req.burst = 1; // INCR
+            inv_req.snoop = enc_::ARSNOOP::CLEAN_INVALID;
+
+            rreq_flit_t inv_flit;
+            inv_flit.type = HEAD;
+            inv_flit.set_network(THIS_ID, THIS_ID, 0, dnp::PACK_TYPE__RD_REQ, 0);
+            inv_flit.set_rd_req(inv_req);
+
+            trans_info_t inv_trans;
+            inv_trans.tag     = tag_inv;
+            inv_trans.snp_cnt = mask_cnt(inv_mask);
+            inv_trans.inval   = true;
+            inv_trans.dct     = false;
+            inv_trans.dmt     = false;
+            inv_trans.spec    = false;
+            inv_trans.req     = inv_flit;
+            inv_trans.wdata_cnt = 0;
+            trans_info.write(inv_trans);
+
+            send_snoops(tag_inv, inv_req, true, THIS_ID.read(), inv_mask, false);
+            #ifndef __SYNTHESIS__
+            sf_back_invals++;
+            std::cout << "[HOME "<< THIS_ID <<"] Snoop filter back-invalidates line " << std::hex << inv_line << std::dec << " Tag: " << tag_inv << " @" << sc_time_stamp() << "\n";
+            #endif
+          }
+
+          if (sf_hit) {
+            sf_busy[sf_set][hit_way] = true;
+            sf_pv[sf_set][hit_way]   = sf_cur_pv | init_2_pv(initiator);
+          } else if (sf_alloc) {
+            sf_valid[sf_set][alloc_way] = true;
+            sf_busy[sf_set][alloc_way]  = true;
+            sf_tag[sf_set][alloc_way]   = line;
+            sf_pv[sf_set][alloc_way]    = init_2_pv(initiator);
+            sf_victim[sf_set]           = (alloc_way + 1) % SF_WAYS_N;
+          }
+
+          trans_info_t new_trans;
+          new_trans.tag     = tag;
+          new_trans.snp_cnt = mask_cnt(snp_mask);
+          new_trans.inval   = false;
+          new_trans.dct     = use_dct;
+          new_trans.dmt     = DMT && may_direct && !use_spec;
+          new_trans.spec    = use_spec;
+          new_trans.req     = held_req;
+          #pragma hls_unroll yes
+          for (int f=0; f<LINE_FLITS; ++f) new_trans.wdata[f] = held_wdata[f];
+          new_trans.wdata_cnt = held_wdata_cnt;
+          trans_info.write(new_trans);
+
+          // Build the appropriate Snoop request for the cached FULL ACE Masters, depending the coherent access
+          send_snoops(tag, cur_req, is_read, initiator, snp_mask, use_dct);
+          #ifndef __SYNTHESIS__
+          if (SF_EN) {
+            if (sf_hit) sf_hits++;
+            else        sf_misses++;
+          }
+          snoops_sent  += mask_cnt(snp_mask);
+          snoops_bcast += init_is_full ? cfg::FULL_MASTER_NUM-1 : cfg::FULL_MASTER_NUM;
+          dct_reqs     += use_dct;
+          #endif
+          req_held = false;
+        }
+      }
       wait();
-      // Initial Request
-      // Wait until a read or write request is received
-      rreq_flit_t flit_req_rcv;
-      bool got_new_req = false;
-      do {
-        if (!got_new_req) got_new_req = wr_from_master.PopNB(flit_req_rcv);
-        if (!got_new_req) got_new_req = rd_from_master.PopNB(flit_req_rcv);
-        wait();
-      } while (!got_new_req);
-      
-      // Check who initiated the transaction the the type of transaction
-      ace5_::AddrPayload  cur_req;
-      unsigned initiator = flit_req_rcv.get_src();
-      bool     is_read   = (flit_req_rcv.get_type() == dnp::PACK_TYPE__RD_REQ);
-      bool     is_write  = (flit_req_rcv.get_type() == dnp::PACK_TYPE__WR_REQ);
-      NVHLS_ASSERT_MSG(is_read ^ is_write , "ERROR : Home got request of wrong type.");
-      flit_req_rcv.get_rd_req(cur_req);
-      
-      #ifndef __SYNTHESIS__
-      if(is_read) std::cout << "[HOME "<< THIS_ID <<"] Got RD from " << initiator << " : " << cur_req << " @" << sc_time_stamp() << "\n";
-      else        std::cout << "[HOME "<< THIS_ID <<"] Got WR from " << initiator << " : " << cur_req << " @" << sc_time_stamp() << "\n";
-      #endif
-      NVHLS_ASSERT_MSG(((flit_req_rcv.data[0].to_uint() >> dnp::D_PTR) & ((1<<dnp::D_W)-1)) == (THIS_ID.read().to_uint()), "Flit misrouted!");
-  
-      // Build the appropriate Snoop request for the cached FULL ACE Masters, depending the coherent access
-      ace5_::AC snoop_req;
-      snoop_req.addr  = cur_req.addr;
-      snoop_req.snoop = is_read ? ace::rd_2_snoop(cur_req.snoop) : ace::wr_2_snoop(cur_req.snoop);
-      snoop_req.prot  = initiator;
-  
-      creq_flit_t flit_snoop;
-      flit_snoop.type = SINGLE; // Entire request fits in single flits thus SINGLE
-      flit_snoop.set_network(THIS_ID, 0, 0, (is_read ? dnp::PACK_TYPE__RD_REQ : dnp::PACK_TYPE__WR_REQ), 0);
-      flit_snoop.set_snoop_req(snoop_req);
-  
-      // Send the Snoop requests to the masters. This can exploit multicast capabilities of the routers
-      for (int i=cfg::SLAVE_NUM; i<cfg::SLAVE_NUM+cfg::FULL_MASTER_NUM; ++i) {
-        if(i!=initiator) {
-          flit_snoop.set_dst(i);
+    } // End of while(1)
+  }; // End of Admission
+
+#ifndef __SYNTHESIS__
+  void end_of_simulation() {
+    if (SF_EN) {
+      std::cout << "[HOME "<< THIS_ID <<"] Snoop filter Hits: " << sf_hits << ", Misses: " << sf_misses
+                << ", Back-invalidations: " << sf_back_invals << "\n";
+    }
+    std::cout << "[HOME "<< THIS_ID <<"] Snoops sent: " << snoops_sent << " of " << snoops_bcast << " broadcast";
+    if (snoops_bcast) std::cout << " (" << (100.0*(snoops_bcast-snoops_sent))/snoops_bcast << "% saved)";
+    std::cout << "\n";
+    if (DCT) {
+      std::cout << "[HOME "<< THIS_ID <<"] Direct Cache Transfers: " << dct_hits << " of " << dct_reqs << " requested\n";
+    }
+    if (DMT) {
+      std::cout << "[HOME "<< THIS_ID <<"] Direct Memory Transfers: " << dmt_reads << "\n";
+    }
+    if (SPEC_RD) {
+      std::cout << "[HOME "<< THIS_ID <<"] Speculative Memory reads: " << spec_reads << ", Wasted: " << spec_wasted;
+      if (spec_reads) std::cout << " (" << (100.0*spec_wasted)/spec_reads << "%)";
+      std::cout << "\n";
+    }
+  };
+#endif
+
+  // Sends a tagged Snoop request to every master of the mask. A DCT Snoop carries the initiator's request as well.
+  inline void send_snoops(const tag_t tag, ace5_::AddrPayload &req, const bool is_read,
+                          const sc_uint<dnp::S_W> initiator, const master_mask_t mask, const bool dct)
+  {
+    ace5_::AC snoop_req;
+    snoop_req.addr  = req.addr;
+    snoop_req.snoop = is_read ? ace::rd_2_snoop(req.snoop) : ace::wr_2_snoop(req.snoop);
+    snoop_req.prot  = req.prot;
+
+    creq_flit_t flit_snoop;
+    flit_snoop.type    = SINGLE; // Entire request fits in single flits thus SINGLE
+    flit_snoop.data[0] = ((sc_uint<dnp::PHIT_W>)tag << dnp::ace::creq::HID_PTR);
+    flit_snoop.set_network(THIS_ID, 0, 0, (is_read ? dnp::PACK_TYPE__RD_REQ : dnp::PACK_TYPE__WR_REQ), 0);
+    flit_snoop.set_snoop_req(snoop_req);
+    if (dct) flit_snoop.set_dct_req(req, !req_denies_dirty(req.snoop, true), initiator);
+    #ifndef __SYNTHESIS__
+    if (mask != 0) ace_home_snoop_inits()[req.addr.to_uint64()].push_back(initiator.to_uint());
+    #endif
+
+    // Send the Snoop requests to the masters, either as one multicast flit or one flit per master
+    if (SNP_MCAST) {
+      if (mask != 0) {
+        flit_snoop.set_mcast(((sc_uint<dnp::MCAST_W>)mask) << cfg::SLAVE_NUM);
+        cache_req.Push(flit_snoop);
+      }
+    } else {
+      for (int i=0; i<cfg::FULL_MASTER_NUM; ++i) {
+        if (mask[i]) {
+          flit_snoop.set_dst(i+cfg::SLAVE_NUM);
           cache_req.Push(flit_snoop);
-          wait();
         }
       }
-      
-      // Depending the initiating master (Lite or Full Ace) different number of request/repsonses are expected
-      bool init_is_full  = (initiator<(cfg::SLAVE_NUM+cfg::FULL_MASTER_NUM));
-      unsigned resp_wait = init_is_full ? cfg::FULL_MASTER_NUM-1 : cfg::FULL_MASTER_NUM;
-      // Wait until all responses are received
-      cresp_flit_t snoop_resp_data;
-      ace5_::CR::Resp resp_accum = 0;
-      bool got_data  = false;
-      bool got_dirty = false;
-      while (resp_wait) {
-        cresp_flit_t flit_rcv_snoop_resp = cache_resp.Pop();
+    }
+  };
+
+  // Snoop filter presence vector conversions. A bit covers SF_GRP consecutive Full masters.
+  inline sf_pv_t master_2_pv(const master_mask_t mask) {
+    sf_pv_t pv = 0;
+    #pragma hls_unroll yes
+    for (int m=0; m<cfg::FULL_MASTER_NUM; ++m) {
+      if (mask[m]) pv[m/SF_GRP] = 1;
+    }
+    return pv;
+  };
+
+  inline master_mask_t pv_2_master(const sf_pv_t pv) {
+    master_mask_t mask = 0;
+    #pragma hls_unroll yes
+    for (int m=0; m<cfg::FULL_MASTER_NUM; ++m) mask[m] = pv[m/SF_GRP];
+    return mask;
+  };
+
+  // A Full initiator caches the line. Lite masters are never tracked.
+  inline sf_pv_t init_2_pv(const sc_uint<dnp::S_W> initiator) {
+    sf_pv_t pv = 0;
+    if ((initiator >= cfg::SLAVE_NUM) && (initiator < (cfg::SLAVE_NUM+cfg::FULL_MASTER_NUM)))
+      pv[(initiator-cfg::SLAVE_NUM)/SF_GRP] = 1;
+    return pv;
+  };
+
+  inline sc_uint<dnp::S_W+1> mask_cnt(const master_mask_t mask) {
+    sc_uint<dnp::S_W+1> cnt = 0;
+    #pragma hls_unroll yes
+    for (int m=0; m<cfg::FULL_MASTER_NUM; ++m) cnt += mask[m];
+    return cnt;
+  };
+
+  // The response of a transaction got sent. A Full Master is expected to ACK in the order it got the responses
+  inline void resp_sent(const tag_t tag) {
+    sc_uint<dnp::S_W> initiator = trans_table[tag].initiator;
+    bool init_is_full = (initiator<(cfg::SLAVE_NUM+cfg::FULL_MASTER_NUM));
+    if (init_is_full) {
+      unsigned master = initiator - cfg::SLAVE_NUM;
+      bool     is_rd  = trans_table[tag].is_read;
+      trans_table[tag].ack_seq  = resp_cnt[master][is_rd];
+      trans_table[tag].wait_ack = true;
+      resp_cnt[master][is_rd]++;
+    }
+    trans_table[tag].pending--;
+  };
+
+  //------------------------------------------//
+  //--- Snoop gathering and Memory access ---//
+  //------------------------------------------//
+  void snoop_gather () {
+    cache_resp.Reset();
+    rd_to_slave.Reset();
+    wr_to_slave.Reset();
+
+    #pragma hls_unroll yes
+    for (int i=0; i<TRANS_NUM; ++i) {
+      trans_pend_valid[i] = false;
+      resp_wait[i]        = 0;
+      resp_accum[i]       = 0;
+      retained[i]         = 0;
+      got_data[i]         = false;
+      got_dirty[i]        = false;
+      got_fwd[i]          = false;
+    }
+    //-- End of Reset ---//
+    wait();
+    while(1) {
+      // New transaction from admission. It precedes its Snoop responses.
+      trans_info_t new_trans;
+      if (trans_info.nb_read(new_trans)) {
+        trans_pend[new_trans.tag]       = new_trans;
+        trans_pend_valid[new_trans.tag] = true;
+        resp_wait[new_trans.tag]        = new_trans.snp_cnt;
+
+        // The speculative Memory read departs along with the Snoops
+        if (new_trans.spec) {
+          ace5_::AddrPayload spec_req;
+          new_trans.req.get_rd_req(spec_req);
+
+          rd_job_t spec_job;
+          spec_job.tag        = new_trans.tag;
+          spec_job.mem        = addr_lut(spec_req.addr);
+          spec_job.from_mem   = false;
+          spec_job.direct     = false;
+          spec_job.spec_rd    = true;
+          spec_job.spec_issue = true;
+          rd_jobs.write(spec_job);
+
+          rreq_flit_t mem_req_flit = new_trans.req;
+          mem_req_flit.set_network(THIS_ID, spec_job.mem, 0, dnp::PACK_TYPE__C_RD_REQ, 0);
+          rd_to_slave.Push(mem_req_flit);
+          #ifndef __SYNTHESIS__
+          spec_reads++;
+          #endif
+        }
+      }
+
+      // Each response is checked if it contains data and accumulate the response to conclude to an action
+      cresp_flit_t flit_rcv_snoop_resp;
+      if (cache_resp.PopNB(flit_rcv_snoop_resp)) {
         NVHLS_ASSERT_MSG((flit_rcv_snoop_resp.type == HEAD || flit_rcv_snoop_resp.type == SINGLE), "Snoop Responce Must be at HEAD/SINGLE flit.");
-        
-        // Each response is checked if it contains data and accumulate the response to conclude to an action
+        tag_t tag = (flit_rcv_snoop_resp.data[0] >> dnp::ace::cresp::HID_PTR) & ((1<<dnp::ace::HID_W)-1);
+
         ace5_::CR::Resp cur_snoop_resp;
         cur_snoop_resp = (flit_rcv_snoop_resp.data[0] >> dnp::ace::cresp::C_RESP_PTR) & ((1<<dnp::ace::C_RESP_W)-1);
         bool has_data  = cur_snoop_resp & 0x1;
         bool has_dirty = cur_snoop_resp & 0x4;
-        if (has_data) {
-          if (has_dirty || !got_data) {
-            snoop_resp_data = cache_resp.Pop();  // Get data
-            NVHLS_ASSERT_MSG((snoop_resp_data.type == TAIL), "Currently a single flit cache line is supported!");
-          } else {
-            cresp_flit_t drop_data = cache_resp.Pop();                    // Already got Data, thus drop any other
-            NVHLS_ASSERT_MSG((drop_data.type == TAIL), "Currently a single flit cache line is supported!" );
-          }
+        bool fwd       = (flit_rcv_snoop_resp.data[0] >> dnp::ace::cresp::DCT_PTR) & 1; // Data went to the initiator
+        if (has_data && !fwd) {
+          // The cache line streams as a flit per beat. Already got Data, thus drop any other but Dirty
+          bool keep_data = has_dirty || !got_data[tag];
+          sc_uint<8> beat = 0;
+          cresp_flit_t data_rcv;
+          do {
+            data_rcv = cache_resp.Pop();
+            NVHLS_ASSERT_MSG(beat<LINE_FLITS, "Snoop data exceed a cache line.");
+            if (keep_data) snoop_resp_data[tag][beat] = data_rcv;
+            beat++;
+          } while (!data_rcv.is_tail());
+          NVHLS_ASSERT_MSG(beat==LINE_FLITS, "Snoop data must carry an entire cache line.");
         }
-        resp_accum |= cur_snoop_resp;
-        got_dirty  |= cur_snoop_resp & 0x4;
-        got_data   |= cur_snoop_resp & 0x1;
-        resp_wait--;
+        resp_accum[tag] |= cur_snoop_resp;
+        if (cur_snoop_resp & 0x8) retained[tag] |= ((master_mask_t)1) << (flit_rcv_snoop_resp.get_src() - cfg::SLAVE_NUM);
+        got_dirty[tag]  |= has_dirty;
+        got_data[tag]   |= has_data;
+        got_fwd[tag]    |= fwd;
+        resp_wait[tag]--;
       }
-      
-      // If initiator demands clean, update Mem in case of dirty line
-      bool update_mem = req_denies_dirty(cur_req.snoop, is_read);
-      if (got_dirty && update_mem) {
-        unsigned mem_to_write = addr_lut(cur_req.addr);
-        wreq_flit_t mem_upd_flit;
-        mem_upd_flit.type = HEAD;
-        mem_upd_flit.data[0] = flit_req_rcv.data[0];
-        mem_upd_flit.data[1] = flit_req_rcv.data[1];
-        mem_upd_flit.data[2] = flit_req_rcv.data[2];
-        mem_upd_flit.set_network(THIS_ID, mem_to_write, 0, dnp::PACK_TYPE__C_WR_REQ, 0);
-        
-        wr_to_slave.Push(mem_upd_flit);
-        #pragma hls_unroll yes
-        for (int i=0; i<cfg::WREQ_PHITS; ++i) {
-          mem_upd_flit.data[i] = snoop_resp_data.data[i] | (((sc_uint<dnp::PHIT_W>)3) << dnp::ace::wdata::E0_PTR);
+
+      // Conclude to an action for a transaction that got all its responses
+      bool  fin_found = false;
+      tag_t fin_tag   = 0;
+      #pragma hls_unroll yes
+      for (int i=0; i<TRANS_NUM; ++i) {
+        if (!fin_found && trans_pend_valid[i] && (resp_wait[i] == 0)) {
+          fin_found = true;
+          fin_tag   = i;
         }
-        mem_upd_flit.type = TAIL;
-        wr_to_slave.Push(mem_upd_flit);
-        wr_from_slave.Pop(); // ToDo : Maybe error handling
-        
-        resp_accum = resp_accum & 0x1B; // Drop Pass Dirty bit as it got writen in Mem
       }
-      
-      if (is_read) {
-        bool data_are_expected = req_expects_data(cur_req.snoop, is_read);
-        // After responces are gathered, either respond to initiating master, or ask Main_mem/LLC
-        if (data_are_expected) {
+
+      if (fin_found) {
+        trans_info_t cur_trans = trans_pend[fin_tag];
+        trans_pend_valid[fin_tag] = false;
+
+        ace5_::AddrPayload cur_req;
+        cur_trans.req.get_rd_req(cur_req);
+        unsigned initiator = cur_trans.req.get_src();
+        bool     is_read   = (cur_trans.req.get_type() == dnp::PACK_TYPE__RD_REQ);
+        unsigned mem_tgt   = addr_lut(cur_req.addr);
+
+        ace5_::CR::Resp cur_accum = resp_accum[fin_tag];
+        bool            cur_got_data = got_data[fin_tag];
+        bool            cur_got_fwd  = got_fwd[fin_tag];
+
+        // If initiator demands clean, update Mem in case of dirty line
+        bool update_mem = got_dirty[fin_tag] && req_denies_dirty(cur_req.snoop, is_read);
+
+        home_gather_upd g_upd;
+        g_upd.tag      = fin_tag;
+        g_upd.wb       = update_mem;
+        g_upd.retained = retained[fin_tag];
+
+        resp_accum[fin_tag] = 0;
+        retained[fin_tag]   = 0;
+        got_data[fin_tag]   = false;
+        got_dirty[fin_tag]  = false;
+        got_fwd[fin_tag]    = false;
+
+        // Inform admission and the response stage before any request reaches the Slave
+        gather_upd.write(g_upd);
+        if (update_mem || !is_read) {
+          home_wr_job wr_job;
+          wr_job.tag       = fin_tag;
+          wr_job.mem       = mem_tgt;
+          wr_job.initiator = initiator;
+          wr_job.wb        = update_mem;
+          wr_job.wr        = !is_read;
+          wr_jobs.write(wr_job);
+        }
+
+        if (update_mem) {
+          // The write-back covers the entire line, a beat per flit
+          ace5_::AddrPayload wb_req = cur_req;
+          wb_req.addr  = (cur_req.addr >> LOG_LINE_BYTES) << LOG_LINE_BYTES;
+          wb_req.len   = LINE_FLITS-1;
+          wb_req.size  = LOG_FLIT_BYTES;
+          wb_req.burst = 1; // INCR
+
+          wreq_flit_t mem_upd_flit;
+          mem_upd_flit.type = HEAD;
+          mem_upd_flit.set_wr_req(wb_req);
+          mem_upd_flit.set_network(THIS_ID, mem_tgt, 0, dnp::PACK_TYPE__C_WR_REQ, 0);
+          wr_to_slave.Push(mem_upd_flit);
+
+          for (int f=0; f<LINE_FLITS; ++f) {
+            #pragma hls_unroll yes
+            for (int i=0; i<cfg::WREQ_PHITS; ++i) {
+              mem_upd_flit.data[i] = snoop_resp_data[fin_tag][f].data[i] | (((sc_uint<dnp::PHIT_W>)3) << dnp::ace::wdata::E0_PTR);
+            }
+            mem_upd_flit.type = (f==LINE_FLITS-1) ? TAIL : BODY;
+            wr_to_slave.Push(mem_upd_flit);
+          }
+
+          cur_accum = cur_accum & 0x1B; // Drop Pass Dirty bit as it got writen in Mem
+        }
+
+        if (cur_trans.inval) {
+          // Back-invalidation is complete once any dirty data are written back
+        } else if (is_read) {
+          rd_job_t rd_job;
+          rd_job.tag      = fin_tag;
+          rd_job.mem      = mem_tgt;
+          rd_job.from_mem = false;
+          rd_job.direct   = false;
+          rd_job.spec_rd  = cur_trans.spec;
+          rd_job.spec_issue = false;
+          rd_job.head.type = HEAD;
+          rd_job.head.set_network(THIS_ID, initiator, 0, dnp::PACK_TYPE__C_RD_RESP, 0);
+          rd_job.head.set_rd_resp(cur_req);
+
+          // The response carries the line beats that the request covers
+          sc_uint<8> first_flit = (cur_req.addr >> LOG_FLIT_BYTES) & (LINE_FLITS-1);
+          sc_uint<8> resp_flits = ((((cur_req.len.to_uint()+1) << cur_req.size.to_uint()) - 1) >> LOG_FLIT_BYTES) + 1;
+          NVHLS_ASSERT_MSG((first_flit+resp_flits) <= LINE_FLITS, "Coherent Read exceeds a cache line.");
+          rd_job.data_cnt = resp_flits;
+
+          bool data_are_expected = req_expects_data(cur_req.snoop, is_read);
           // After responces are gathered, either respond to initiating master, or ask Main_mem/LLC
-          if (!got_data) { //  Didn't get data response, thus  ask memory
-            //  Didn't get data response, thus  ask memory
-            unsigned mem_to_req = addr_lut(cur_req.addr);
-            flit_req_rcv.set_network(THIS_ID, mem_to_req, 0, dnp::PACK_TYPE__C_RD_REQ, 0);
-      
-            rd_to_slave.Push(flit_req_rcv);
-      
-            rd_from_slave.Pop(); // Drop the header
-      
-            snoop_resp_data = rd_from_slave.Pop();
-            resp_accum = ((snoop_resp_data.data[0] >> dnp::ace::rdata::RE_PTR) & 0x3) | (resp_accum & 0xC);
+          if (data_are_expected) {
+            if (!cur_got_data) {
+              //  Didn't get data response, thus  ask memory. With DMT the Slave responds to the initiator
+              rd_job.from_mem = !cur_trans.dmt;
+              rd_job.direct   = cur_trans.dmt;
+              rd_job.resp     = cur_accum;
+              rd_jobs.write(rd_job);
+
+              // A speculative read is already on its way
+              if (!cur_trans.spec) {
+                rreq_flit_t mem_req_flit = cur_trans.req;
+                mem_req_flit.set_network(THIS_ID, mem_tgt, 0, dnp::PACK_TYPE__C_RD_REQ, 0);
+                if (cur_trans.dmt) mem_req_flit.set_dmt_req(initiator, cur_accum & 0xC); // IsShared and PassDirty
+                rd_to_slave.Push(mem_req_flit);
+              }
+              #ifndef __SYNTHESIS__
+              if (cur_trans.dmt) dmt_reads++;
+              #endif
+            } else if (cur_got_fwd) {
+              // The snooped master has already responded to the initiator
+              rd_job.direct = true;
+              rd_jobs.write(rd_job);
+              #ifndef __SYNTHESIS__
+              dct_hits++;
+              #endif
+            } else {
+              cur_accum = cur_accum & 0xE; // MASK WasUnique and HasData. Easily creating the R resp from CR resp
+              #pragma hls_unroll yes
+              for (int f=0; f<LINE_FLITS; ++f) {
+                #pragma hls_unroll yes
+                for (int i=0; i<cfg::RRESP_PHITS; ++i) {
+                  rd_job.data[f].data[i] = snoop_resp_data[fin_tag][(first_flit+f) & (LINE_FLITS-1)].data[i] |
+                                           (((sc_uint<dnp::PHIT_W>)cur_accum) << dnp::ace::rdata::RE_PTR);
+                }
+                rd_job.data[f].type = (f==resp_flits-1) ? TAIL : BODY;
+              }
+              rd_jobs.write(rd_job);
+            }
           } else {
-            resp_accum = resp_accum & 0xE; // MASK WasUnique and HasData. Easily creating the R resp from CR resp
+            // Master does not expect Data, thus build empty data+response
+            cur_accum = cur_accum & 0xE; // MASK WasUnique and HasData. Easily creating the R resp from CR resp
+            #pragma hls_unroll yes
+            for (int f=0; f<LINE_FLITS; ++f) {
+              #pragma hls_unroll yes
+              for (int i=0; i<cfg::RRESP_PHITS; ++i) {
+                rd_job.data[f].data[i] = (((sc_uint<dnp::PHIT_W>) cur_accum) << dnp::ace::rdata::RE_PTR);
+              }
+              rd_job.data[f].type = (f==resp_flits-1) ? TAIL : BODY;
+            }
+            rd_jobs.write(rd_job);
           }
-          #pragma hls_unroll yes
-          for (int i=0; i<cfg::RRESP_PHITS; ++i) {
-            snoop_resp_data.data[i] |= snoop_resp_data.data[i] | (((sc_uint<dnp::PHIT_W>)resp_accum) << dnp::ace::rdata::RE_PTR);
+        } else {
+          // Init transaction is a Write thus resolve Mem to write and send the Write transaction
+          wreq_flit_t wr_head = cur_trans.req;
+          wr_head.set_network(THIS_ID, mem_tgt, 0, dnp::PACK_TYPE__C_WR_REQ, 0);
+          wr_to_slave.Push(wr_head);
+          for (int f=0; f<cur_trans.wdata_cnt; ++f) wr_to_slave.Push(cur_trans.wdata[f]);
+        }
+      }
+      wait();
+    } // End of while(1)
+  }; // End of Snoop gathering
+
+  //-------------------------//
+  //--- Read Responses ---//
+  //-------------------------//
+  void rd_resp_job () {
+    rd_to_master.Reset();
+    rd_from_slave.Reset();
+
+    #pragma hls_unroll yes
+    for (int i=0; i<cfg::SLAVE_NUM; ++i) rd_order[i].reset();
+    #pragma hls_unroll yes
+    for (int i=0; i<TRANS_NUM; ++i) {
+      spec_on[i]  = false;
+      spec_ret[i] = false;
+      spec_res[i] = false;
+      spec_use[i] = false;
+    }
+    //-- End of Reset ---//
+    wait();
+    while(1) {
+      rd_job_t rd_job;
+      if (rd_jobs.nb_read(rd_job)) {
+        tag_t tag = rd_job.tag;
+        if (rd_job.spec_issue) {
+          // The speculative read departed. Its data wait for the Snoops to conclude
+          spec_on[tag]  = true;
+          spec_ret[tag] = false;
+          spec_res[tag] = false;
+          spec_cnt[tag] = 0;
+          rd_order[rd_job.mem].push(tag);
+        } else if (rd_job.from_mem) {
+          // Wait for the Memory. Its responses are in the order of the requests
+          rd_pend[tag] = rd_job;
+          if (rd_job.spec_rd) {
+            spec_res[tag] = true;
+            spec_use[tag] = true;
+            if (spec_ret[tag]) {
+              // The speculative data have already returned
+              rd_to_master.Push(rd_job.head); // Send Header flit
+              for (int f=0; f<spec_cnt[tag]; ++f) rd_to_master.Push(merge_resp(spec_data[tag][f], rd_job.resp));
+              spec_on[tag] = false;
+              rd_upd.write(tag);
+              rd_upd.write( (((tag_flag_t)1) << dnp::ace::HID_W) | tag );
+            }
+          } else {
+            rd_order[rd_job.mem].push(tag);
           }
         } else {
-          // Master does not expect Data, thus build empty data+response And write any data received to Mem
-          resp_accum = resp_accum & 0xE; // MASK WasUnique and HasData. Easily creating the R resp from CR resp
-          #pragma hls_unroll yes
-          for (int i=0; i<cfg::RRESP_PHITS; ++i) {
-            snoop_resp_data.data[i] = (((sc_uint<dnp::PHIT_W>) resp_accum) << dnp::ace::rdata::RE_PTR);
+          if (!rd_job.direct) {
+            rd_to_master.Push(rd_job.head); // Send Header flit
+            for (int f=0; f<rd_job.data_cnt; ++f) rd_to_master.Push(rd_job.data[f]); // Send Data
+          }
+          rd_upd.write(tag);
+          // A cache supplied the line, thus the speculative data get dropped
+          if (rd_job.spec_rd) {
+            spec_res[tag] = true;
+            spec_use[tag] = false;
+            if (spec_ret[tag]) {
+              spec_on[tag] = false;
+              rd_upd.write( (((tag_flag_t)1) << dnp::ace::HID_W) | tag );
+            }
+            #ifndef __SYNTHESIS__
+            spec_wasted++;
+            #endif
           }
-          snoop_resp_data.type = TAIL;
         }
-        // Build and send reponse packet
-        rresp_flit_t flit_resp_to_init;
-        flit_resp_to_init.type  = HEAD;
-        flit_resp_to_init.set_network(THIS_ID, initiator, 0, dnp::PACK_TYPE__C_RD_RESP, 0);
-        flit_resp_to_init.set_rd_resp(cur_req);
-  
-        rd_to_master.Push(flit_resp_to_init); // Send Header flit
-        rd_to_master.Push(snoop_resp_data);   // Send Data. IsSHared and IsDirty are expected to be 0
-      } else {
-        // Init transaction is a Write thus resolbe Mem to write and send the Write transaction
-        unsigned mem_to_write = addr_lut(cur_req.addr);
-        flit_req_rcv.set_network(THIS_ID, mem_to_write, 0, dnp::PACK_TYPE__C_WR_REQ, 0);
-        wr_to_slave.Push(flit_req_rcv); // Send Head
-        
-        wreq_flit_t data_to_update;
-        while(!wr_from_master.PopNB(data_to_update)) {
-          wait();
+      }
+
+      // The job of a request precedes it, but may still wait in rd_jobs while a Push above blocks.
+      //   Thus a Memory response is accepted only after its tag got ordered.
+      rresp_flit_t mem_head;
+      if (rd_from_slave.PeekNB(mem_head) && rd_order[mem_head.get_src()].valid()) {
+        mem_head = rd_from_slave.Pop();
+        tag_t    tag  = rd_order[mem_head.get_src()].pop();
+        rd_job_t cur  = rd_pend[tag];
+
+        if (spec_on[tag] && !spec_res[tag]) {
+          // Speculative data arrived before the Snoops concluded. Buffer them
+          rresp_flit_t mem_data;
+          do {
+            mem_data = rd_from_slave.Pop();
+            NVHLS_ASSERT_MSG(spec_cnt[tag]<LINE_FLITS, "Speculative read exceeds a cache line.");
+            spec_data[tag][spec_cnt[tag]] = mem_data;
+            spec_cnt[tag]++;
+          } while (!mem_data.is_tail());
+          spec_ret[tag] = true;
+        } else if (spec_on[tag] && !spec_use[tag]) {
+          // Wasted speculative data
+          rresp_flit_t mem_data;
+          do {
+            mem_data = rd_from_slave.Pop();
+          } while (!mem_data.is_tail());
+          spec_on[tag] = false;
+          rd_upd.write( (((tag_flag_t)1) << dnp::ace::HID_W) | tag );
+        } else {
+          rd_to_master.Push(cur.head); // Send Header flit
+          // Stream the Data flits, merging the Snoop response. IsSHared and IsDirty are expected to be 0
+          rresp_flit_t mem_data;
+          do {
+            mem_data = rd_from_slave.Pop();
+            rd_to_master.Push(merge_resp(mem_data, cur.resp));
+          } while (!mem_data.is_tail());
+          rd_upd.write(tag);
+          if (spec_on[tag]) {
+            spec_on[tag] = false;
+            rd_upd.write( (((tag_flag_t)1) << dnp::ace::HID_W) | tag );
+          }
         }
-        wr_to_slave.Push(data_to_update);
-  
-        // transfer the response to the init Master
-        wresp_flit_t mv_wr_resp = wr_from_slave.Pop();
-        mv_wr_resp.set_src(THIS_ID); // Set the HOME src to receive the response
-        mv_wr_resp.set_dst(initiator); // Set the initiator as a recipient  src to receive the response
-        wr_to_master.Push(mv_wr_resp);
       }
-      
-      // Wait for the final ack from the Init Master that signifies that the cache has been completed the transaction
-      // Only a Full Master responds with an Ack
-      if (init_is_full) {
-        ack_flit_t rcv_ack = ack_from_master.Pop();
-        NVHLS_ASSERT_MSG( (rcv_ack.is_rack()&&is_read) || (rcv_ack.is_wack()&&(!is_read)), "ACK does not match the responce (i.e. RD/WR)");
-
-        #ifndef __SYNTHESIS__
-        if(is_read) std::cout << "[HOME "<< THIS_ID <<"] Got RD ACK from " << rcv_ack.get_src() << " : " << cur_req << " @" << sc_time_stamp() << "\n";
-        else        std::cout << "[HOME "<< THIS_ID <<"] Got WR AK  from " << rcv_ack.get_src() << " : " << cur_req << " @" << sc_time_stamp() << "\n";
-        #endif
+      wait();
+    } // End of while(1)
+  }; // End of Read Responses
+
+  //-------------------------//
+  //--- Write Responses ---//
+  //-------------------------//
+  void wr_resp_job () {
+    wr_to_master.Reset();
+    wr_from_slave.Reset();
+
+    #pragma hls_unroll yes
+    for (int i=0; i<cfg::SLAVE_NUM; ++i) wr_order[i].reset();
+    //-- End of Reset ---//
+    wait();
+    while(1) {
+      home_wr_job wr_job;
+      if (wr_jobs.nb_read(wr_job)) {
+        wr_pend[wr_job.tag] = wr_job;
+        wr_order[wr_job.mem].push(wr_job.tag);
       }
-      
-      
+
+      // As with the Reads, a Memory response is accepted only after its tag got ordered,
+      //   since the Push below may block while wr_jobs holds the jobs of other Slaves.
+      wresp_flit_t mv_wr_resp;
+      if (wr_from_slave.PeekNB(mv_wr_resp) && wr_order[mv_wr_resp.get_src()].valid()) {
+        mv_wr_resp = wr_from_slave.Pop();
+        unsigned mem = mv_wr_resp.get_src();
+        tag_t    tag = wr_order[mem].peek();
+        if (wr_pend[tag].wb) {
+          // The write-back precedes the initiator's write
+          wr_pend[tag].wb = false;
+          if (!wr_pend[tag].wr) wr_order[mem].pop();
+          wr_upd.write( (((tag_flag_t)1) << dnp::ace::HID_W) | tag );
+        } else {
+          wr_order[mem].pop();
+          // transfer the response to the init Master
+          mv_wr_resp.set_src(THIS_ID);                  // Set the HOME src to receive the response
+          mv_wr_resp.set_dst(wr_pend[tag].initiator);   // Set the initiator as a recipient  src to receive the response
+          wr_to_master.Push(mv_wr_resp);
+          wr_upd.write(tag);
+        }
+      }
+      wait();
     } // End of while(1)
-  }; // End of HOME Node
-  
+  }; // End of Write Responses
+
+  // Merges the Snoop response to a Memory data flit
+  inline rresp_flit_t merge_resp(rresp_flit_t mem_data, const sc_uint<dnp::ace::C_RESP_W> snp_resp) {
+    sc_uint<dnp::ace::C_RESP_W> resp = ((mem_data.data[0] >> dnp::ace::rdata::RE_PTR) & 0x3) | (snp_resp & 0xC);
+    #pragma hls_unroll yes
+    for (int i=0; i<cfg::RRESP_PHITS; ++i) {
+      mem_data.data[i] |= (((sc_uint<dnp::PHIT_W>)resp) << dnp::ace::rdata::RE_PTR);
+    }
+    return mem_data;
+  };
+
   // Transactions that do not accept Dirty data, thus the interconnects is responsible for to handle them
   inline bool req_denies_dirty(NVUINTW(enc_::ARSNOOP::_WIDTH) &request_in, bool is_read ) {
     if (is_read) {
@@ -285,7 +1231,7 @@ SC_MODULE(ace_home) {
     }
     return false;
   };
-    
+
     // When data are required, HOME must access Mem when all snoops where missed
   inline bool req_expects_data(NVUINTW(enc_::ARSNOOP::_WIDTH) &request_in, bool is_read ) {
     if (is_read) {
@@ -300,13 +1246,10 @@ SC_MODULE(ace_home) {
     }
     return false;
   };
-  
-  // Memory map resolving 
+
+  // Memory map resolving
   inline unsigned char addr_lut(const ace5_::Addr addr) {
-    for (int i=0; i<2; ++i) {
-      if (addr>=addr_map[i][0].read() && addr <= addr_map[i][1].read()) return i;
-    }
-    return 0; // Or send 404
+    return addr_dec<cfg::SLAVE_NUM>::get(addr, addr_map);
   };
 }; // End of Home module
 
@@ -0,0 +1,795 @@
+// --------------------------------------------------------- //
+//     LLC - System level cache beside the HOME-NODE         //
+// --------------------------------------------------------- //
+
+#ifndef _ACE_LLC_H_
+#define _ACE_LLC_H_
+
+#include "systemc.h"
+#include "nvhls_connections.h"
+
+#include "../include/ace.h"
+#include "../include/flit_ace.h"
+#include "../include/duth_fun.h"
+#include "../include/fifo_queue_oh.h"
+
+// Replacement policies of the LLC
+enum LLC_REPL_POLICY {
+  LLC_REPL_RR  = 0, // Round-Robin per set
+  LLC_REPL_LRU = 1  // Least Recently Used, by an age per way
+};
+
+// Jobs of the data array stage
+enum LLC_JOB {
+  LLC_JOB_RD = 0, // Read response towards HOME, from the line. A fill waits for the line from Memory
+  LLC_JOB_WR = 1, // Merges Write data to the line
+  LLC_JOB_EV = 2  // Reads out a dirty victim to be written back to Memory
+};
+
+// --- Helping Data structures --- //
+// Job passed from lookup to the data array stage.
+template <typename rresp_flit_t, typename wreq_flit_t, unsigned LINE_FLITS>
+struct llc_data_job {
+  sc_uint<2>        kind;
+  sc_uint<4>        tag;
+  sc_uint<dnp::D_W> mem;        // The slave that serves the line
+  sc_uint<16>       set;
+  sc_uint<4>        way;
+  bool              fill;       // A Read miss, waiting for the line from Memory. For a Write, it allocates the line
+  sc_uint<8>        first_flit; // The line flits that the request covers
+  sc_uint<8>        flit_cnt;
+  rresp_flit_t      head;       // Read response header towards HOME
+  wreq_flit_t       wdata[LINE_FLITS];
+
+  inline friend std::ostream& operator << ( std::ostream& os, const llc_data_job& job ) {
+    os <<"Kind: "<< job.kind <<", Tag: "<< job.tag <<", Mem: "<< job.mem <<", Set: "<< job.set <<", Way: "<< job.way
+       <<", Fill: "<< job.fill <<", Flits: "<< job.first_flit <<"+"<< job.flit_cnt;
+    return os;
+  }
+
+#ifdef SYSTEMC_INCLUDED
+  // Only for SystemC
+  inline friend void sc_trace(sc_trace_file* tf, const llc_data_job& job, const std::string& name) {
+    sc_trace(tf, job.kind,       name + ".kind");
+    sc_trace(tf, job.tag,        name + ".tag");
+    sc_trace(tf, job.mem,        name + ".mem");
+    sc_trace(tf, job.set,        name + ".set");
+    sc_trace(tf, job.way,        name + ".way");
+    sc_trace(tf, job.fill,       name + ".fill");
+    sc_trace(tf, job.first_flit, name + ".first_flit");
+    sc_trace(tf, job.flit_cnt,   name + ".flit_cnt");
+    sc_trace(tf, job.head,       name + ".head");
+    for (unsigned i=0; i<LINE_FLITS; ++i) sc_trace(tf, job.wdata[i], name + ".wdata_" + std::to_string(i));
+  }
+#endif
+};
+
+// Write job. Orders the Write responses towards HOME, and the Memory Write responses to expect.
+template <typename wresp_flit_t>
+struct llc_wr_job {
+  sc_uint<4>        tag;    // The slot, or the eviction entry
+  sc_uint<dnp::D_W> mem;
+  bool              local;  // The LLC absorbed the Write, thus responds without Memory
+  bool              evict;  // Write-back of a dirty victim. Its response is consumed by the LLC
+  wresp_flit_t      resp;   // Response of a local Write
+
+  inline friend std::ostream& operator << ( std::ostream& os, const llc_wr_job& job ) {
+    os <<"Tag: "<< job.tag <<", Mem: "<< job.mem <<", Local: "<< job.local <<", Evict: "<< job.evict;
+    return os;
+  }
+
+#ifdef SYSTEMC_INCLUDED
+  // Only for SystemC
+  inline friend void sc_trace(sc_trace_file* tf, const llc_wr_job& job, const std::string& name) {
+    sc_trace(tf, job.tag,   name + ".tag");
+    sc_trace(tf, job.mem,   name + ".mem");
+    sc_trace(tf, job.local, name + ".local");
+    sc_trace(tf, job.evict, name + ".evict");
+    sc_trace(tf, job.resp,  name + ".resp");
+  }
+#endif
+};
+
+// --- LLC ---
+// A set-associative system level cache, placed between a HOME and the NoC towards the Slaves.
+//   It appears as the Slaves to HOME and as HOME to the Slaves, thus HOME is unaware of it.
+//   Every Memory access of HOME passes through it, i.e. the Reads of the coherent misses,
+//   the dirty write-backs and the coherent Writes. LLC_SETS x LLC_WAYS lines of a coherent cache line each.
+//   - Read hits respond without Memory. Read misses fill the entire line from Memory, and then respond
+//   - Writes that hit merge their data, and those that cover an entire line allocate it. Both respond
+//     without Memory, thus dirty write-backs get absorbed. Partial Write misses are written through to Memory.
+//   - Dirty victims are written back to Memory. A Read of a line waits for its write-back to complete
+//   The replacement policy is LLC_REPL_RR (Round-Robin) or LLC_REPL_LRU (Least Recently Used).
+//   Up to TRANS_NUM requests are in flight. A Slave responds in order, thus the LLC responds to HOME in the
+//   order of each Slave, as HOME expects. HOME serializes the accesses to a line, hence only a Memory fill and
+//   a Read response in flight keep their line busy. The LLC comprises 3 parallel stages:
+//   - lookup_job  : Looks the tags up, allocates the lines and issues the Memory accesses
+//   - data_job    : Owns the data array. Fills, merges and evicts lines, and sends the Read responses
+//   - wr_resp_job : Sinks the write-back responses and sends the Write responses
+//   Direct Memory Transfers would bypass the LLC, thus HOME must have DMT disabled.
+//   With LLC_SETS=0 the LLC is transparent, and simply forwards the flits.
+template <typename cfg, unsigned LLC_SETS=64, unsigned LLC_WAYS=4, unsigned LLC_REPL=LLC_REPL_LRU, unsigned TRANS_NUM=4>
+SC_MODULE(ace_llc) {
+  typedef typename ace::ace5<axi::cfg::ace> ace5_;
+
+  typedef flit_dnp<cfg::RREQ_PHITS>  rreq_flit_t;
+  typedef flit_dnp<cfg::RRESP_PHITS> rresp_flit_t;
+  typedef flit_dnp<cfg::WREQ_PHITS>  wreq_flit_t;
+  typedef flit_dnp<cfg::WRESP_PHITS> wresp_flit_t;
+
+  // A line keeps a data beat per flit, as HOME does
+  static const unsigned LINE_FLITS     = ace5_::C_LINE_BEATS;
+  static const unsigned LOG_FLIT_BYTES = nvhls::log2_ceil<(ace5_::C_DATA_CHAN_WIDTH>>3)>::val;
+  static const unsigned LOG_LINE_BYTES = nvhls::log2_ceil<(ace5_::C_CACHE_WIDTH>>3)>::val;
+
+  // Arrays keep a single entry when the LLC is disabled
+  static const bool     LLC_EN    = (LLC_SETS>0);
+  static const unsigned SETS_N    = LLC_EN ? LLC_SETS : 1;
+  static const unsigned WAYS_N    = LLC_EN ? LLC_WAYS : 1;
+  static const unsigned LOG_SETS  = nvhls::log2_ceil<SETS_N>::val;
+  static const unsigned LOG_TRANS = nvhls::log2_ceil<TRANS_NUM>::val;
+
+  typedef sc_uint<LOG_TRANS+1>                   tag_t;
+  typedef sc_uint<LOG_TRANS+2>                   tag_flag_t; // Tag with a flag at the MSB
+  typedef sc_uint<LOG_SETS+1>                    set_t;
+  typedef sc_uint<4>                             way_t;
+  typedef sc_uint<dnp::ace::AH_W+dnp::ace::AL_W> line_t;
+  typedef sc_uint<dnp::ace::B_W*2>               phit_data_t; // The data bytes of a phit
+
+  typedef llc_data_job<rresp_flit_t, wreq_flit_t, LINE_FLITS> data_job_t;
+  typedef llc_wr_job<wresp_flit_t>                            wr_job_t;
+
+  sc_in_clk    clk;
+  sc_in <bool> rst_n;
+
+  sc_in< sc_uint<dnp::S_W> > THIS_ID; // The ID of the HOME it serves
+
+  // HOME side
+  Connections::In<rreq_flit_t>   INIT_S1(rd_from_home);
+  Connections::Out<rresp_flit_t> INIT_S1(rd_to_home);
+
+  Connections::In<wreq_flit_t>   INIT_S1(wr_from_home);
+  Connections::Out<wresp_flit_t> INIT_S1(wr_to_home);
+
+  // NoC side, towards the Slaves
+  Connections::Out<rreq_flit_t> INIT_S1(rd_to_slave);
+  Connections::In<rresp_flit_t> INIT_S1(rd_from_slave);
+
+  Connections::Out<wreq_flit_t> INIT_S1(wr_to_slave);
+  Connections::In<wresp_flit_t> INIT_S1(wr_from_slave);
+
+  // --- Internals --- //
+  // FIFOs that pass the requests between the stages
+  sc_fifo<data_job_t>  INIT_S1(data_jobs);   // Lookup -> Data
+  sc_fifo<wr_job_t>    INIT_S1(wr_jobs);     // Lookup -> WR resp
+  sc_fifo<wreq_flit_t> INIT_S1(evict_data);  // Data   -> Lookup | The flits of an evicted line
+
+  // FIFOs that inform the lookup stage about progress
+  sc_fifo<tag_t>       INIT_S1(rd_upd);      // Data    -> Lookup | Read response sent
+  sc_fifo<tag_flag_t>  INIT_S1(wr_upd);      // WR resp -> Lookup | MSB: an eviction completed, else Write response sent
+
+  // Placed on lookup
+  bool              slot_valid[TRANS_NUM];
+  set_t             slot_set[TRANS_NUM];
+  way_t             slot_way[TRANS_NUM];
+  bool              ev_valid[TRANS_NUM];      // Write-backs of dirty victims in flight
+  line_t            ev_line[TRANS_NUM];
+
+  bool              llc_valid[SETS_N][WAYS_N];
+  bool              llc_dirty[SETS_N][WAYS_N];
+  bool              llc_busy[SETS_N][WAYS_N];  // A Memory fill or a Read response is in flight
+  line_t            llc_tag[SETS_N][WAYS_N];
+  sc_uint<dnp::D_W> llc_mem[SETS_N][WAYS_N];   // The Slave of the line, to address its write-back
+  way_t             llc_age[SETS_N][WAYS_N];   // LRU, 0 is the most recently used
+  way_t             llc_victim[SETS_N];        // Round-Robin
+
+#ifndef __SYNTHESIS__
+  // LLC statistics
+  unsigned long long rd_hits, rd_misses;
+  unsigned long long wr_hits, wr_allocs, wr_through; // Writes merged, allocated as entire lines, and written through
+  unsigned long long evictions;                      // Dirty victims written back
+#endif
+
+  // Placed on data
+  phit_data_t                   llc_data[SETS_N][WAYS_N][LINE_FLITS][cfg::RRESP_PHITS];
+  sc_uint<2>                    llc_resp[SETS_N][WAYS_N]; // AXI response of the fill
+  data_job_t                    rd_pend[TRANS_NUM];
+  bool                          rd_ready[TRANS_NUM];
+  fifo_queue<tag_t, TRANS_NUM>  rd_order[cfg::SLAVE_NUM];   // Read responses towards HOME
+  fifo_queue<tag_t, TRANS_NUM>  fill_order[cfg::SLAVE_NUM]; // Fills to expect from Memory
+
+  // Placed on WR response
+  wresp_flit_t                  wr_resp[TRANS_NUM];
+  bool                          wr_ready[TRANS_NUM];
+  fifo_queue<tag_t, TRANS_NUM>       wr_order[cfg::SLAVE_NUM];  // Write responses towards HOME
+  fifo_queue<tag_flag_t, TRANS_NUM*2> mem_order[cfg::SLAVE_NUM]; // Memory Write responses to expect. MSB flags an eviction
+
+  // Constructor
+  SC_HAS_PROCESS(ace_llc);
+  ace_llc(sc_module_name name_="ace_llc")
+    :
+    sc_module  (name_),
+    data_jobs  (2*TRANS_NUM),
+    wr_jobs    (2*TRANS_NUM),
+    evict_data (LINE_FLITS),
+    rd_upd     (TRANS_NUM),
+    wr_upd     (2*TRANS_NUM)
+  {
+    NVHLS_ASSERT_MSG((TRANS_NUM>0) && (TRANS_NUM<=8), "LLC supports 1 to 8 outstanding requests.");
+    NVHLS_ASSERT_MSG(!LLC_EN || (((LLC_SETS & (LLC_SETS-1)) == 0) && (LLC_WAYS>0) && (LLC_WAYS<=16)), "LLC sets must be a power of 2, ways 1 to 16.");
+    NVHLS_ASSERT_MSG((LINE_FLITS>0) && ((ace5_::C_DATA_CHAN_WIDTH>>4) == cfg::RRESP_PHITS) &&
+                     (cfg::RRESP_PHITS == cfg::WREQ_PHITS), "LLC expects a data beat per Read/Write data flit.");
+
+    SC_THREAD(lookup_job);
+    sensitive << clk.pos();
+    async_reset_signal_is(rst_n, false);
+
+    SC_THREAD(data_job);
+    sensitive << clk.pos();
+    async_reset_signal_is(rst_n, false);
+
+    SC_THREAD(wr_resp_job);
+    sensitive << clk.pos();
+    async_reset_signal_is(rst_n, false);
+  }
+
+  //-----------------------------------//
+  //--- Lookup and Memory accesses ---//
+  //-----------------------------------//
+  void lookup_job () {
+    rd_from_home.Reset();
+    wr_from_home.Reset();
+    rd_to_slave.Reset();
+    wr_to_slave.Reset();
+
+    #pragma hls_unroll yes
+    for (int i=0; i<TRANS_NUM; ++i) {
+      slot_valid[i] = false;
+      ev_valid[i]   = false;
+    }
+    #pragma hls_unroll yes
+    for (int s=0; s<SETS_N; ++s) {
+      llc_victim[s] = 0;
+      #pragma hls_unroll yes
+      for (int w=0; w<WAYS_N; ++w) {
+        llc_valid[s][w] = false;
+        llc_dirty[s][w] = false;
+        llc_busy[s][w]  = false;
+        llc_age[s][w]   = w;
+      }
+    }
+#ifndef __SYNTHESIS__
+    rd_hits = 0; rd_misses = 0;
+    wr_hits = 0; wr_allocs = 0; wr_through = 0;
+    evictions = 0;
+#endif
+
+    bool        req_held   = false; // A received request that waits for a free slot, or for its line
+    bool        held_is_wr = false;
+    rreq_flit_t held_rd;
+    wreq_flit_t held_wr;
+    wreq_flit_t held_wdata[LINE_FLITS];
+    sc_uint<8>  held_wdata_cnt = 0;
+    bool        held_all_strb  = false; // Every byte of the Write data is enabled
+    bool        rd_prio = false;        // Alternates RD/WR requests
+    //-- End of Reset ---//
+    wait();
+    while(1) {
+      if (!LLC_EN) {
+        // Transparent
+        rreq_flit_t fwd_rd;
+        if (rd_from_home.PopNB(fwd_rd)) rd_to_slave.Push(fwd_rd);
+        wreq_flit_t fwd_wr;
+        if (wr_from_home.PopNB(fwd_wr)) wr_to_slave.Push(fwd_wr);
+      } else {
+        // --- Progress of the in-flight requests --- //
+        tag_t done_tag;
+        if (rd_upd.nb_read(done_tag)) {
+          // The Read response got sent, thus its line may be accessed again
+          llc_busy[slot_set[done_tag]][slot_way[done_tag]] = false;
+          slot_valid[done_tag] = false;
+        }
+
+        tag_flag_t wr_done;
+        if (wr_upd.nb_read(wr_done)) {
+          tag_t idx = wr_done.range(LOG_TRANS, 0);
+          if (wr_done[LOG_TRANS+1]) ev_valid[idx]   = false; // The write-back of a victim completed
+          else                      slot_valid[idx] = false; // The Write response got sent
+        }
+
+        // --- Admission of a new request --- //
+        if (!req_held) {
+          held_is_wr = false;
+          if (rd_prio) {
+            req_held = rd_from_home.PopNB(held_rd);
+            if (!req_held) req_held = held_is_wr = wr_from_home.PopNB(held_wr);
+          } else {
+            req_held = held_is_wr = wr_from_home.PopNB(held_wr);
+            if (!req_held) req_held = rd_from_home.PopNB(held_rd);
+          }
+          rd_prio = !rd_prio;
+          // Write data follow their header, up to a cache line
+          if (held_is_wr) {
+            held_wdata_cnt = 0;
+            held_all_strb  = true;
+            bool got_tail  = false;
+            while (!got_tail) {
+              wreq_flit_t wdata_flit;
+              if (wr_from_home.PopNB(wdata_flit)) {
+                NVHLS_ASSERT_MSG(held_wdata_cnt<LINE_FLITS, "LLC Write exceeds a cache line.");
+                held_wdata[held_wdata_cnt] = wdata_flit;
+                #pragma hls_unroll yes
+                for (int i=0; i<cfg::WREQ_PHITS; ++i) {
+                  held_all_strb = held_all_strb && (((wdata_flit.data[i] >> dnp::ace::wdata::E0_PTR) & 0x3) == 0x3);
+                }
+                held_wdata_cnt++;
+                got_tail = wdata_flit.is_tail();
+              } else {
+                wait();
+              }
+            }
+          }
+        }
+
+        if (req_held) {
+          ace5_::AddrPayload cur_req;
+          sc_uint<dnp::D_W>  mem;
+          if (held_is_wr) {
+            held_wr.get_rd_req(cur_req);
+            mem = held_wr.get_dst();
+          } else {
+            held_rd.get_rd_req(cur_req);
+            mem = held_rd.get_dst();
+            NVHLS_ASSERT_MSG(!held_rd.is_dmt(), "LLC requires HOME without Direct Memory Transfer.");
+          }
+
+          line_t     line       = (cur_req.addr.to_uint() >> LOG_LINE_BYTES);
+          set_t      set        = line & (SETS_N-1);
+          sc_uint<8> first_flit = (cur_req.addr >> LOG_FLIT_BYTES) & (LINE_FLITS-1);
+          sc_uint<8> req_flits  = ((((cur_req.len.to_uint()+1) << cur_req.size.to_uint()) - 1) >> LOG_FLIT_BYTES) + 1;
+          NVHLS_ASSERT_MSG((first_flit+req_flits) <= LINE_FLITS, "LLC access exceeds a cache line.");
+          bool       full_line  = held_is_wr && held_all_strb && (first_flit == 0) && (held_wdata_cnt == LINE_FLITS);
+
+          // Tag lookup
+          bool  hit      = false;
+          bool  hit_busy = false;
+          way_t hit_way  = 0;
+          #pragma hls_unroll yes
+          for (int w=0; w<WAYS_N; ++w) {
+            if (llc_valid[set][w] && (llc_tag[set][w] == line)) {
+              hit      = true;
+              hit_busy = llc_busy[set][w];
+              hit_way  = w;
+            }
+          }
+
+          // A free slot, a free eviction entry, and a pending write-back of the line
+          bool  got_slot = false;
+          tag_t tag      = 0;
+          bool  got_ev   = false;
+          tag_t ev_idx   = 0;
+          bool  ev_pend  = false;
+          #pragma hls_unroll yes
+          for (int i=0; i<TRANS_NUM; ++i) {
+            if (!slot_valid[i] && !got_slot) {
+              got_slot = true;
+              tag      = i;
+            }
+            if (!ev_valid[i] && !got_ev) {
+              got_ev = true;
+              ev_idx = i;
+            }
+            ev_pend = ev_pend || (ev_valid[i] && (ev_line[i] == line));
+          }
+
+          // Read misses fill the line, Writes of an entire line allocate it, the rest of Writes go through
+          bool  got_vict   = false;
+          way_t vict_way   = pick_victim(set, got_vict);
+          bool  vict_dirty = llc_valid[set][vict_way] && llc_dirty[set][vict_way];
+          bool  alloc      = !hit && (!held_is_wr || full_line);
+          bool  through    = !hit && held_is_wr && !full_line;
+          way_t way        = hit ? hit_way : vict_way;
+
+          bool  ready = got_slot && !hit_busy &&
+                        (!alloc || (got_vict && (!vict_dirty || got_ev))) &&
+                        (held_is_wr || !ev_pend);
+
+          if (ready) {
+            #ifndef __SYNTHESIS__
+            if(!held_is_wr) std::cout << "[LLC "<< THIS_ID <<"] Got RD " << (hit ? "Hit" : "Miss") << " : " << cur_req << " Tag: " << tag << " @" << sc_time_stamp() << "\n";
+            else            std::cout << "[LLC "<< THIS_ID <<"] Got WR " << (hit ? "Hit" : (full_line ? "Alloc" : "Through")) << " : " << cur_req << " Tag: " << tag << " @" << sc_time_stamp() << "\n";
+            #endif
+            slot_valid[tag] = true;
+            slot_set[tag]   = set;
+            slot_way[tag]   = way;
+
+            if (alloc) {
+              if (vict_dirty) write_back(set, vict_way, ev_idx);
+              llc_valid[set][way] = true;
+              llc_dirty[set][way] = false;
+              llc_tag[set][way]   = line;
+              llc_mem[set][way]   = mem;
+              llc_victim[set]     = (way + 1) % WAYS_N;
+            }
+            if (!through) touch(set, way);
+
+            if (!held_is_wr) {
+              // The line stays busy until its Read response gets sent
+              llc_busy[set][way] = true;
+
+              data_job_t rd_job;
+              rd_job.kind       = LLC_JOB_RD;
+              rd_job.tag        = tag;
+              rd_job.mem        = mem;
+              rd_job.set        = set;
+              rd_job.way        = way;
+              rd_job.fill       = alloc;
+              rd_job.first_flit = first_flit;
+              rd_job.flit_cnt   = req_flits;
+              rd_job.head.type  = HEAD;
+              rd_job.head.set_network(mem, THIS_ID, 0, dnp::PACK_TYPE__C_RD_RESP, 0);
+              rd_job.head.set_rd_resp(cur_req);
+              data_jobs.write(rd_job);
+
+              // The fill covers the entire line. A common ID lets the Slave keep the fills in flight
+              if (alloc) {
+                ace5_::AddrPayload fill_req;
+                fill_req.id    = 0;
+                fill_req.addr  = ((ace5_::Addr)line) << LOG_LINE_BYTES;
+                fill_req.len   = LINE_FLITS-1;
+                fill_req.size  = LOG_FLIT_BYTES;
+                fill_req.burst = 1; // INCR
+
+                rreq_flit_t fill_flit;
+                fill_flit.type = SINGLE;
+                fill_flit.set_rd_req(fill_req);
+                fill_flit.set_network(THIS_ID, mem, 0, dnp::PACK_TYPE__C_RD_REQ, 0);
+                rd_to_slave.Push(fill_flit);
+              }
+              #ifndef __SYNTHESIS__
+              if (hit) rd_hits++;
+              else     rd_misses++;
+              #endif
+            } else {
+              wr_job_t wr_job;
+              wr_job.tag   = tag;
+              wr_job.mem   = mem;
+              wr_job.local = !through;
+              wr_job.evict = false;
+              wr_job.resp.type    = SINGLE;
+              wr_job.resp.data[0] = ((sc_uint<dnp::PHIT_W>)cur_req.id << dnp::ace::wresp::ID_PTR); // OKAY
+              wr_job.resp.set_network(mem, THIS_ID, 0, dnp::PACK_TYPE__C_WR_RESP, 0);
+              wr_jobs.write(wr_job);
+
+              if (through) {
+                wr_to_slave.Push(held_wr);
+                for (int f=0; f<held_wdata_cnt; ++f) wr_to_slave.Push(held_wdata[f]);
+              } else {
+                llc_dirty[set][way] = true;
+
+                data_job_t merge_job;
+                merge_job.kind       = LLC_JOB_WR;
+                merge_job.tag        = tag;
+                merge_job.mem        = mem;
+                merge_job.set        = set;
+                merge_job.way        = way;
+                merge_job.fill       = alloc; // The Write allocates the entire line
+                merge_job.first_flit = first_flit;
+                merge_job.flit_cnt   = held_wdata_cnt;
+                #pragma hls_unroll yes
+                for (int f=0; f<LINE_FLITS; ++f) merge_job.wdata[f] = held_wdata[f];
+                data_jobs.write(merge_job);
+              }
+              #ifndef __SYNTHESIS__
+              if      (hit)     wr_hits++;
+              else if (through) wr_through++;
+              else              wr_allocs++;
+              #endif
+            }
+            req_held = false;
+          }
+        }
+      }
+      wait();
+    } // End of while(1)
+  }; // End of Lookup
+
+#ifndef __SYNTHESIS__
+  void end_of_simulation() {
+    if (LLC_EN) {
+      unsigned long long rd_all = rd_hits + rd_misses;
+      unsigned long long wr_all = wr_hits + wr_allocs + wr_through;
+      std::cout << "[LLC "<< THIS_ID <<"] Read hits: " << rd_hits << " of " << rd_all;
+      if (rd_all) std::cout << " (" << (100.0*rd_hits)/rd_all << "%)";
+      std::cout << ", Write hits: " << wr_hits << ", allocations: " << wr_allocs << ", write-throughs: " << wr_through;
+      if (wr_all) std::cout << " (" << (100.0*(wr_hits+wr_allocs))/wr_all << "% absorbed)";
+      std::cout << ", Dirty evictions: " << evictions << "\n";
+    }
+  };
+#endif
+
+  // The victim of a set. An invalid way first, else by the policy among the ways that are not busy
+  inline way_t pick_victim(const set_t set, bool &got_vict) {
+    bool  got_inv  = false;
+    way_t inv_way  = 0;
+    bool  got_repl = false;
+    way_t repl_way = 0;
+    way_t max_age  = 0;
+    #pragma hls_unroll yes
+    for (int w=0; w<WAYS_N; ++w) {
+      if (!llc_valid[set][w] && !llc_busy[set][w] && !got_inv) {
+        got_inv = true;
+        inv_way = w;
+      }
+      if ((LLC_REPL == LLC_REPL_LRU) && !llc_busy[set][w] && (!got_repl || (llc_age[set][w] > max_age))) {
+        got_repl = true;
+        repl_way = w;
+        max_age  = llc_age[set][w];
+      }
+    }
+    if (LLC_REPL != LLC_REPL_LRU) {
+      #pragma hls_unroll yes
+      for (int i=0; i<WAYS_N; ++i) {
+        unsigned w = (llc_victim[set] + i) % WAYS_N;
+        if (!llc_busy[set][w] && !got_repl) {
+          got_repl = true;
+          repl_way = w;
+        }
+      }
+    }
+    got_vict = got_inv || got_repl;
+    return got_inv ? inv_way : repl_way;
+  };
+
+  // An access makes the way the most recently used of its set
+  inline void touch(const set_t set, const way_t way) {
+    way_t cur_age = llc_age[set][way];
+    #pragma hls_unroll yes
+    for (int w=0; w<WAYS_N; ++w) {
+      if (llc_age[set][w] < cur_age) llc_age[set][w]++;
+    }
+    llc_age[set][way] = 0;
+  };
+
+  // Writes back a dirty victim. The data array stage reads it out, while its Memory response gets expected
+  inline void write_back(const set_t set, const way_t way, const tag_t ev_idx) {
+    line_t            ev_line_addr = llc_tag[set][way];
+    sc_uint<dnp::D_W> ev_mem       = llc_mem[set][way];
+
+    data_job_t ev_job;
+    ev_job.kind       = LLC_JOB_EV;
+    ev_job.tag        = ev_idx;
+    ev_job.mem        = ev_mem;
+    ev_job.set        = set;
+    ev_job.way        = way;
+    ev_job.fill       = false;
+    ev_job.first_flit = 0;
+    ev_job.flit_cnt   = LINE_FLITS;
+    data_jobs.write(ev_job);
+
+    wr_job_t wr_job;
+    wr_job.tag   = ev_idx;
+    wr_job.mem   = ev_mem;
+    wr_job.local = false;
+    wr_job.evict = true;
+    wr_jobs.write(wr_job);
+
+    ace5_::AddrPayload wb_req;
+    wb_req.id    = 0;
+    wb_req.addr  = ((ace5_::Addr)ev_line_addr) << LOG_LINE_BYTES;
+    wb_req.len   = LINE_FLITS-1;
+    wb_req.size  = LOG_FLIT_BYTES;
+    wb_req.burst = 1; // INCR
+
+    wreq_flit_t wb_head;
+    wb_head.type = HEAD;
+    wb_head.set_wr_req(wb_req);
+    wb_head.set_network(THIS_ID, ev_mem, 0, dnp::PACK_TYPE__C_WR_REQ, 0);
+    wr_to_slave.Push(wb_head);
+    for (int f=0; f<LINE_FLITS; ++f) wr_to_slave.Push(evict_data.read());
+
+    ev_valid[ev_idx] = true;
+    ev_line[ev_idx]  = ev_line_addr;
+    llc_dirty[set][way] = false;
+    #ifndef __SYNTHESIS__
+    evictions++;
+    std::cout << "[LLC "<< THIS_ID <<"] Writes back line " << std::hex << ev_line_addr << std::dec << " @" << sc_time_stamp() << "\n";
+    #endif
+  };
+
+  //----------------------------------------//
+  //--- Data array and Read responses ---//
+  //----------------------------------------//
+  void data_job () {
+    rd_to_home.Reset();
+    rd_from_slave.Reset();
+
+    #pragma hls_unroll yes
+    for (int i=0; i<cfg::SLAVE_NUM; ++i) {
+      rd_order[i].reset();
+      fill_order[i].reset();
+    }
+    #pragma hls_unroll yes
+    for (int i=0; i<TRANS_NUM; ++i) rd_ready[i] = false;
+    //-- End of Reset ---//
+    wait();
+    while(1) {
+      if (!LLC_EN) {
+        // Transparent
+        rresp_flit_t fwd_flit;
+        if (rd_from_slave.PopNB(fwd_flit)) rd_to_home.Push(fwd_flit);
+      } else {
+        data_job_t job;
+        if (data_jobs.nb_read(job)) apply_job(job);
+
+        // A fill of the line, from Memory
+        rresp_flit_t mem_head;
+        if (rd_from_slave.PopNB(mem_head)) {
+          // The fill job precedes its Memory request, yet it may still wait in the job queue
+          while (!fill_order[mem_head.get_src()].valid()) apply_job(data_jobs.read());
+          tag_t      tag = fill_order[mem_head.get_src()].pop();
+          data_job_t cur = rd_pend[tag];
+          sc_uint<8> beat = 0;
+          rresp_flit_t mem_data;
+          do {
+            mem_data = rd_from_slave.Pop();
+            NVHLS_ASSERT_MSG(beat<LINE_FLITS, "LLC fill exceeds a cache line.");
+            #pragma hls_unroll yes
+            for (int i=0; i<cfg::RRESP_PHITS; ++i) llc_data[cur.set][cur.way][beat][i] = mem_data.data[i] & ((1<<(2*dnp::ace::B_W))-1);
+            beat++;
+          } while (!mem_data.is_tail());
+          llc_resp[cur.set][cur.way] = (mem_data.data[0] >> dnp::ace::rdata::RE_PTR) & 0x3;
+          rd_ready[tag] = true;
+        }
+
+        // Respond for a Slave whose oldest Read is ready
+        bool  resp_found = false;
+        tag_t resp_tag   = 0;
+        #pragma hls_unroll yes
+        for (int s=0; s<cfg::SLAVE_NUM; ++s) {
+          if (!resp_found && rd_order[s].valid() && rd_ready[rd_order[s].peek()]) {
+            resp_found = true;
+            resp_tag   = rd_order[s].pop();
+          }
+        }
+        if (resp_found) {
+          data_job_t cur = rd_pend[resp_tag];
+          rd_ready[resp_tag] = false;
+          rd_to_home.Push(cur.head); // Send Header flit
+          // The response carries the line beats that the request covers
+          for (int f=0; f<cur.flit_cnt; ++f) {
+            sc_uint<8>   lf = (cur.first_flit + f) & (LINE_FLITS-1);
+            rresp_flit_t resp_flit;
+            #pragma hls_unroll yes
+            for (int i=0; i<cfg::RRESP_PHITS; ++i) {
+              resp_flit.data[i] = ((sc_uint<dnp::PHIT_W>)llc_resp[cur.set][cur.way]  << dnp::ace::rdata::RE_PTR) |
+                                  ((sc_uint<dnp::PHIT_W>)(f==cur.flit_cnt-1)          << dnp::ace::rdata::LA_PTR) |
+                                  ((sc_uint<dnp::PHIT_W>)llc_data[cur.set][cur.way][lf][i] << dnp::ace::rdata::B0_PTR);
+            }
+            resp_flit.type = (f==cur.flit_cnt-1) ? TAIL : BODY;
+            rd_to_home.Push(resp_flit);
+          }
+          rd_upd.write(resp_tag);
+        }
+      }
+      wait();
+    } // End of while(1)
+  }; // End of Data array
+
+  // Registers a job on the data array
+  inline void apply_job(const data_job_t &job) {
+    if (job.kind == LLC_JOB_RD) {
+      // Responses follow the order of their Slave. A fill waits for the Memory
+      tag_t tag = job.tag;
+      rd_pend[tag]  = job;
+      rd_ready[tag] = !job.fill;
+      rd_order[job.mem].push(tag);
+      if (job.fill) fill_order[job.mem].push(tag);
+    } else if (job.kind == LLC_JOB_WR) {
+      // A line that a Write allocated has no Memory response, thus it responds OKAY
+      if (job.fill) llc_resp[job.set][job.way] = 0;
+      // Merge the enabled bytes, a beat per flit
+      #pragma hls_unroll yes
+      for (int f=0; f<LINE_FLITS; ++f) {
+        if (f < job.flit_cnt) {
+          sc_uint<8> lf = (job.first_flit + f) & (LINE_FLITS-1);
+          #pragma hls_unroll yes
+          for (int i=0; i<cfg::WREQ_PHITS; ++i) {
+            sc_uint<dnp::PHIT_W> wphit = job.wdata[f].data[i];
+            phit_data_t          cur   = llc_data[job.set][job.way][lf][i];
+            if ((wphit >> dnp::ace::wdata::E0_PTR) & 1) cur.range(dnp::ace::B_W-1, 0)               = (wphit >> dnp::ace::wdata::B0_PTR) & ((1<<dnp::ace::B_W)-1);
+            if ((wphit >> dnp::ace::wdata::E1_PTR) & 1) cur.range(2*dnp::ace::B_W-1, dnp::ace::B_W) = (wphit >> dnp::ace::wdata::B1_PTR) & ((1<<dnp::ace::B_W)-1);
+            llc_data[job.set][job.way][lf][i] = cur;
+          }
+        }
+      }
+    } else {
+      // Read out the victim as Write data flits
+      for (int f=0; f<LINE_FLITS; ++f) {
+        wreq_flit_t ev_flit;
+        #pragma hls_unroll yes
+        for (int i=0; i<cfg::WREQ_PHITS; ++i) {
+          ev_flit.data[i] = ((sc_uint<dnp::PHIT_W>)llc_data[job.set][job.way][f][i] << dnp::ace::wdata::B0_PTR) |
+                            ((sc_uint<dnp::PHIT_W>)(f==LINE_FLITS-1)                 << dnp::ace::wdata::LA_PTR) |
+                            (((sc_uint<dnp::PHIT_W>)3)                               << dnp::ace::wdata::E0_PTR);
+        }
+        ev_flit.type = (f==LINE_FLITS-1) ? TAIL : BODY;
+        evict_data.write(ev_flit);
+      }
+    }
+  };
+
+  //-------------------------//
+  //--- Write Responses ---//
+  //-------------------------//
+  void wr_resp_job () {
+    wr_to_home.Reset();
+    wr_from_slave.Reset();
+
+    #pragma hls_unroll yes
+    for (int i=0; i<cfg::SLAVE_NUM; ++i) {
+      wr_order[i].reset();
+      mem_order[i].reset();
+    }
+    #pragma hls_unroll yes
+    for (int i=0; i<TRANS_NUM; ++i) wr_ready[i] = false;
+    //-- End of Reset ---//
+    wait();
+    while(1) {
+      if (!LLC_EN) {
+        // Transparent
+        wresp_flit_t fwd_flit;
+        if (wr_from_slave.PopNB(fwd_flit)) wr_to_home.Push(fwd_flit);
+      } else {
+        wr_job_t wr_job;
+        if (wr_jobs.nb_read(wr_job)) apply_wr_job(wr_job);
+
+        wresp_flit_t mem_resp;
+        if (wr_from_slave.PopNB(mem_resp)) {
+          while (!mem_order[mem_resp.get_src()].valid()) apply_wr_job(wr_jobs.read());
+          tag_flag_t entry = mem_order[mem_resp.get_src()].pop();
+          tag_t      tag   = entry.range(LOG_TRANS, 0);
+          if (entry[LOG_TRANS+1]) {
+            wr_upd.write(entry); // The write-back of a victim completed
+          } else {
+            wr_resp[tag]  = mem_resp;
+            wr_ready[tag] = true;
+          }
+        }
+
+        // Respond for a Slave whose oldest Write is ready
+        bool  resp_found = false;
+        tag_t resp_tag   = 0;
+        #pragma hls_unroll yes
+        for (int s=0; s<cfg::SLAVE_NUM; ++s) {
+          if (!resp_found && wr_order[s].valid() && wr_ready[wr_order[s].peek()]) {
+            resp_found = true;
+            resp_tag   = wr_order[s].pop();
+          }
+        }
+        if (resp_found) {
+          wr_ready[resp_tag] = false;
+          wr_to_home.Push(wr_resp[resp_tag]);
+          wr_upd.write(resp_tag);
+        }
+      }
+      wait();
+    } // End of while(1)
+  }; // End of Write Responses
+
+  // Registers the Write responses to send towards HOME, and the ones to expect from Memory
+  inline void apply_wr_job(const wr_job_t &wr_job) {
+    tag_t      tag       = wr_job.tag;
+    tag_flag_t mem_entry = (((tag_flag_t)wr_job.evict) << (LOG_TRANS+1)) | tag;
+    if (wr_job.evict) {
+      mem_order[wr_job.mem].push(mem_entry);
+    } else {
+      wr_resp[tag]  = wr_job.resp;
+      wr_ready[tag] = wr_job.local;
+      wr_order[wr_job.mem].push(tag);
+      if (!wr_job.local) mem_order[wr_job.mem].push(mem_entry);
+    }
+  };
+}; // End of LLC module
+
+#endif // _ACE_LLC_H_
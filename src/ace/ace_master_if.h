@@ -15,6 +15,8 @@
 #include "../include/axi4_configs_extra.h"
 #include "../include/flit_ace.h"
 #include "../include/duth_fun.h"
+#include "../include/addr_dec.h"
+#include "../include/home_sel.h"
 
 #define LOG_MAX_OUTS 8
 
@@ -59,7 +61,7 @@ struct order_info {
 // The interface gets the Requests and independently packetize and send them into the network
 // The Responses are getting depacketized into a seperate thread and are fed back to the MASTER
 // Thus Master interface comprises of 4 distinct/paarallel blocks WR/RD pack and WR/RD depack
-template <typename cfg>
+template <typename cfg, unsigned HOME_SEL=HOME_SEL_LINE>
 SC_MODULE(ace_master_if) {
   typedef typename ace::ace5<axi::cfg::ace> ace5_;
   typedef typename axi::AXI4_Encoding       enc_;
@@ -78,6 +80,7 @@ SC_MODULE(ace_master_if) {
   
   const unsigned char LOG_RD_M_LANES = nvhls::log2_ceil<cfg::RD_LANES>::val;
   const unsigned char LOG_WR_M_LANES = nvhls::log2_ceil<cfg::WR_LANES>::val;
+  const unsigned char LOG_BEAT_BYTES = nvhls::log2_ceil<(ace5_::C_DATA_CHAN_WIDTH>>3)>::val;
   
   sc_in_clk    clk;
   sc_in <bool> rst_n;
@@ -113,6 +116,8 @@ SC_MODULE(ace_master_if) {
   
   Connections::In<creq_flit_t>   INIT_S1(cache_flit_in);
   Connections::Out<cresp_flit_t> INIT_S1(cache_flit_out);
+  // Direct Cache Transfer of snooped data to the initiator, through the Read response NoC
+  Connections::Out<rresp_flit_t> INIT_S1(dct_flit_out);
   
   
   // --- READ Internals --- //
@@ -137,6 +142,9 @@ SC_MODULE(ace_master_if) {
     rd_trans_fin  (2),
     wr_trans_fin  (2)
   {
+    NVHLS_ASSERT_MSG(((ace5_::C_DATA_CHAN_WIDTH/8)/2) <= cfg::CRESP_PHITS, "A Snoop Data beat must fit in a Snoop Response flit.");
+    NVHLS_ASSERT_MSG(((ace5_::C_DATA_CHAN_WIDTH/8)/2) <= cfg::RRESP_PHITS, "A Snoop Data beat must fit in a Read Response flit.");
+    
     SC_THREAD(rd_req_pack_job);
     sensitive << clk.pos();
     async_reset_signal_is(rst_n, false);
@@ -169,6 +177,7 @@ SC_MODULE(ace_master_if) {
   
     cache_flit_in.Reset();
     cache_flit_out.Reset();
+    dct_flit_out.Reset();
     
     //-- End of Reset ---//
     wait();
@@ -176,6 +185,8 @@ SC_MODULE(ace_master_if) {
       creq_flit_t flit_snp_rcv = cache_flit_in.Pop();
       
       sc_uint<dnp::D_W> sender = (flit_snp_rcv.data[0] >> dnp::S_PTR) & ((1<<dnp::S_W)-1);
+      // HOME tags each snoop with its transaction slot, which is echoed back to the response
+      sc_uint<dnp::ace::HID_W> home_tid = (flit_snp_rcv.data[0] >> dnp::ace::creq::HID_PTR) & ((1<<dnp::ace::HID_W)-1);
       
       ace5_::AC snoop_req;
       snoop_req.prot  = (flit_snp_rcv.data[2] >> dnp::ace::creq::C_PROT_PTR) & ((1<<dnp::ace::C_PROT_W)-1);
@@ -183,13 +194,28 @@ SC_MODULE(ace_master_if) {
       snoop_req.addr  = ((((flit_snp_rcv.data[2]>>dnp::ace::creq::AH_PTR) & ((1<<dnp::ace::AH_W)-1)) << dnp::ace::AL_W) |
                           ((flit_snp_rcv.data[1]>>dnp::ace::creq::AL_PTR) & ((1<<dnp::ace::AL_W)-1)));
       
-      NVHLS_ASSERT_MSG(((flit_snp_rcv.data[0].to_uint() >> dnp::D_PTR) & ((1<<dnp::D_W)-1)) == (THIS_ID.read().to_uint()), "Flit misrouted!");
+      // A multicast Snoop carries this master in its destination mask
+      sc_uint<dnp::MCAST_W> mc_dst = flit_snp_rcv.get_mcast();
+      bool is_dst = (mc_dst != 0) ? (bool)mc_dst[THIS_ID.read().to_uint()] : (flit_snp_rcv.get_dst() == THIS_ID.read());
+      NVHLS_ASSERT_MSG(is_dst, "Flit misrouted!");
+      
+      // Direct Cache Transfer carries the initiator's request, to respond to it on behalf of HOME
+      bool               dct_req      = flit_snp_rcv.is_dct();
+      bool               dct_dirty_ok = false;
+      sc_uint<dnp::S_W>  dct_init     = 0;
+      ace5_::AddrPayload init_req;
+      if (dct_req) {
+        flit_snp_rcv.get_dct_req(init_req, dct_dirty_ok);
+        dct_init      = flit_snp_rcv.get_dct_init();
+        init_req.addr = snoop_req.addr;
+      }
       ac_out.Push(snoop_req);
       
       ace5_::CR snoop_resp = cr_in.Pop();
       cresp_flit_t resp_flit;
       
-      resp_flit.data[0] = ((sc_uint<dnp::PHIT_W>) snoop_resp.resp          << dnp::ace::cresp::C_RESP_PTR) |
+      resp_flit.data[0] = ((sc_uint<dnp::PHIT_W>) home_tid                 << dnp::ace::cresp::HID_PTR   ) |
+                          ((sc_uint<dnp::PHIT_W>) snoop_resp.resp          << dnp::ace::cresp::C_RESP_PTR) |
                           ((sc_uint<dnp::PHIT_W>)dnp::PACK_TYPE__RD_REQ << dnp::T_PTR       ) |
                           ((sc_uint<dnp::PHIT_W>) 0                     << dnp::Q_PTR       ) |
                           ((sc_uint<dnp::PHIT_W>)sender                  << dnp::D_PTR       ) |
@@ -197,15 +223,56 @@ SC_MODULE(ace_master_if) {
                           ((sc_uint<dnp::PHIT_W>)0                      << dnp::V_PTR       ) ;
       
       bool has_data = (snoop_resp.resp & 1);
-      if (has_data) {
+      // Data are sent directly, unless Dirty data must be written back through HOME
+      bool do_dct   = dct_req && has_data && (dct_dirty_ok || !(snoop_resp.resp & 0x4));
+      resp_flit.data[0] |= ((sc_uint<dnp::PHIT_W>) do_dct << dnp::ace::cresp::DCT_PTR);
+      
+      if (do_dct) {
+        // The response appears to come from HOME, thus the initiator ACKs HOME
+        rresp_flit_t dct_flit;
+        dct_flit.type = HEAD;
+        dct_flit.set_network(sender, dct_init, 0, dnp::PACK_TYPE__C_RD_RESP, 0);
+        dct_flit.set_rd_resp(init_req);
+        dct_flit_out.Push(dct_flit);
+        
+        // Only the beats that the request covers are sent, with the Snoop response as the Read response
+        sc_uint<8> first_beat = (init_req.addr >> LOG_BEAT_BYTES) & (ace5_::C_LINE_BEATS-1);
+        sc_uint<8> last_beat  = first_beat + (((((init_req.len.to_uint()+1) << init_req.size.to_uint()) - 1)) >> LOG_BEAT_BYTES);
+        sc_uint<dnp::ace::R_RE_W> rd_resp = snoop_resp.resp & 0xE; // MASK WasUnique and HasData
+        sc_uint<8> beat = 0;
+        ace5_::CD snoop_data;
+        do {
+          unsigned char data_bytes[ace5_::C_DATA_CHAN_WIDTH/8];
+          snoop_data = cd_in.Pop();
+          if ((beat >= first_beat) && (beat <= last_beat)) {
+            duth_fun<ace5_::CD::Data, ace5_::C_DATA_CHAN_WIDTH/8>::assign_ac2char(data_bytes, snoop_data.data);
+            #pragma hls_unroll yes
+            for(unsigned i=0; i<(ace5_::C_DATA_CHAN_WIDTH/8)/2; ++i) {
+              dct_flit.data[i] = ((sc_uint<dnp::PHIT_W>)rd_resp               << dnp::ace::rdata::RE_PTR ) |
+                                 ((sc_uint<dnp::PHIT_W>)(beat==last_beat)     << dnp::ace::rdata::LA_PTR ) |
+                                 ((sc_uint<dnp::PHIT_W>)data_bytes[(i<<1)+1] << dnp::ace::rdata::B1_PTR ) |
+                                 ((sc_uint<dnp::PHIT_W>)data_bytes[(i<<1)  ] << dnp::ace::rdata::B0_PTR ) ;
+            }
+            dct_flit.type = (beat==last_beat) ? TAIL : BODY;
+            dct_flit_out.Push(dct_flit);
+          }
+          beat++;
+        } while (!snoop_data.last);
+        
+        // HOME gets only the Snoop response
+        resp_flit.type = SINGLE;
+        cache_flit_out.Push(resp_flit);
+      } else if (has_data) {
         resp_flit.type = HEAD;
         cache_flit_out.Push(resp_flit);
+        // The cache line streams as a flit per Snoop Data beat
         ace5_::CD snoop_data;
         do {
-          unsigned char data_bytes[ace5_::C_CACHE_WIDTH/8];
+          unsigned char data_bytes[ace5_::C_DATA_CHAN_WIDTH/8];
           snoop_data = cd_in.Pop();
-          duth_fun<ace5_::CD::Data, ace5_::C_CACHE_WIDTH/8>::assign_ac2char(data_bytes, snoop_data.data);
-          for(unsigned i=0; i<(ace5_::C_CACHE_WIDTH/8)/2; ++i) {
+          duth_fun<ace5_::CD::Data, ace5_::C_DATA_CHAN_WIDTH/8>::assign_ac2char(data_bytes, snoop_data.data);
+          #pragma hls_unroll yes
+          for(unsigned i=0; i<(ace5_::C_DATA_CHAN_WIDTH/8)/2; ++i) {
             resp_flit.data[i] = ((sc_uint<dnp::PHIT_W>)snoop_data.last      << dnp::ace::wdata::LA_PTR ) | // MSB
                                 ((sc_uint<dnp::PHIT_W>)data_bytes[(i<<1)+1] << dnp::ace::wdata::B1_PTR ) |
                                 ((sc_uint<dnp::PHIT_W>)data_bytes[(i<<1)  ] << dnp::ace::wdata::B0_PTR ) ;
@@ -251,7 +318,7 @@ SC_MODULE(ace_master_if) {
         bool is_coherent = (this_req.snoop > 0) || ((this_req.snoop ==0) && (this_req.domain.xor_reduce()));
         
         // resolve address to node-id
-        sc_uint<dnp::D_W> this_dst = is_coherent ? (cfg::SLAVE_NUM+cfg::ALL_MASTER_NUM) : addr_lut_rd(this_req.addr);
+        sc_uint<dnp::D_W> this_dst = is_coherent ? home_lut(this_req.addr) : addr_lut_rd(this_req.addr);
         // Check reorder conditions for received TID.
         bool          may_reorder = (sel_entry.sent>0) && (sel_entry.dst_last != this_dst);
         // In case of possible reordering wait_for has the number of transactions
@@ -445,7 +512,7 @@ SC_MODULE(ace_master_if) {
                                (this_req.snoop == 1);
         
         // resolve address to node-id
-        sc_uint<dnp::D_W> this_dst = pass_thru_home ? (cfg::SLAVE_NUM+cfg::ALL_MASTER_NUM) : addr_lut_wr(this_req.addr);
+        sc_uint<dnp::D_W> this_dst = pass_thru_home ? home_lut(this_req.addr) : addr_lut_wr(this_req.addr);
         
         // Check reorder conditions for this TID.
         //   In an ordered NoC reorder may occur when there are outstanding trans towards different destinations
@@ -636,17 +703,17 @@ SC_MODULE(ace_master_if) {
   
   // Memory map resolving 
   inline unsigned char addr_lut_rd(const ace5_::Addr addr) {
-    for (int i=0; i<2; ++i) {
-      if (addr>=addr_map[i][0].read() && addr <= addr_map[i][1].read()) return i;
-    }
-    return 0; // Or send 404
+    return addr_dec<cfg::SLAVE_NUM>::get(addr, addr_map);
+  };
+  
+  // Coherent transactions resolve to the HOME of their cache line. HOMEs follow the masters in the Node IDs
+  inline unsigned char home_lut(const ace5_::Addr addr) {
+    return cfg::SLAVE_NUM + cfg::ALL_MASTER_NUM +
+           home_sel<cfg::HOME_NUM, HOME_SEL, nvhls::log2_ceil<(ace5_::C_CACHE_WIDTH>>3)>::val>::get(addr, addr_lut_rd(addr));
   };
   
   inline unsigned char addr_lut_wr(const ace5_::Addr addr) {
-    for (int i=0; i<2; ++i) {
-      if (addr>=addr_map[i][0].read() && addr <= addr_map[i][1].read()) return i;
-    }
-    return 0; // Or send 404
+    return addr_dec<cfg::SLAVE_NUM>::get(addr, addr_map);
   };
   
 }; // End of Master-IF module
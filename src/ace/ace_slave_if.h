@@ -27,6 +27,9 @@ struct rd_trans_info_t {
   sc_uint<dnp::ace::LE_W> len;
   sc_uint<dnp::ace::AP_W> addr_part; // Used for resizing at slave
   bool                    is_coherent;
+  bool                    direct;    // Direct Memory Transfer. Respond to the initiator on behalf of HOME (src)
+  sc_uint<dnp::D_W>       init;
+  sc_uint<dnp::ace::R_RE_W> c_resp;  // Coherence bits of the response, given by HOME
   
   inline friend std::ostream& operator << ( std::ostream& os, const rd_trans_info_t& info ) {
     os <<"S: "<< info.src /*<<", D: "<< info.dst*/ <<", TID: "<< info.tid <<", Bu: "<< info.burst <<"Si: "<< info.size <<"Le: "<< info.len /*<<", Ticket: "<<info.reord_tct*/;
@@ -48,6 +51,9 @@ struct rd_trans_info_t {
     sc_trace(tf, info.size,  name + ".size");
     sc_trace(tf, info.len,   name + ".len");
     sc_trace(tf, info.is_coherent,   name + ".coherent");
+    sc_trace(tf, info.direct,        name + ".direct");
+    sc_trace(tf, info.init,          name + ".init");
+    sc_trace(tf, info.c_resp,        name + ".c_resp");
     // Needed only when reordering is supported
     //sc_trace(tf, info.reord_tct,   name + ".ticket");
   }
@@ -220,6 +226,9 @@ SC_MODULE(ace_slave_if) {
         temp_info.burst       = (flit_rcv.data[2] >> dnp::ace::req::BU_PTR) & ((1<<dnp::ace::BU_W)-1);
         temp_info.addr_part   = (flit_rcv.data[1] & ((1<<dnp::ace::AP_W)-1));
         temp_info.is_coherent = (flit_rcv.get_type() > 3);
+        temp_info.direct      = flit_rcv.is_dmt();
+        temp_info.init        = temp_info.direct ? flit_rcv.get_dmt_init() : (sc_uint<dnp::S_W>)0;
+        temp_info.c_resp      = temp_info.direct ? flit_rcv.get_dmt_resp() : (sc_uint<dnp::ace::R_RE_W>)0;
   
         NVHLS_ASSERT(((flit_rcv.data[0].to_uint() >> dnp::D_PTR) & ((1<<dnp::D_W)-1)) == (THIS_ID.read().to_uint()));
         
@@ -254,14 +263,17 @@ SC_MODULE(ace_slave_if) {
       // Then responce data are gathered, packed and again sent to NoC
       rd_trans_info_t this_head = rd_trans_init.read();
       sc_uint<dnp::T_W> packet_type = this_head.is_coherent ? dnp::PACK_TYPE__C_RD_RESP : dnp::PACK_TYPE__RD_RESP ;
+      // A Direct Memory Transfer appears to come from HOME, thus the initiator ACKs HOME
+      sc_uint<dnp::D_W> resp_dst    = this_head.direct ? this_head.init : this_head.src;
+      sc_uint<dnp::S_W> resp_src    = this_head.direct ? this_head.src  : (sc_uint<dnp::S_W>)THIS_ID.read();
       //--- Build header ---
       temp_flit.type    = HEAD;
       temp_flit.data[0] = ((sc_uint<dnp::PHIT_W>)this_head.burst             << dnp::ace::rresp::BU_PTR) |
                           ((sc_uint<dnp::PHIT_W>)this_head.tid               << dnp::ace::rresp::ID_PTR) |
                           ((sc_uint<dnp::PHIT_W>)packet_type              << dnp::T_PTR) |
                           ((sc_uint<dnp::PHIT_W>)0                        << dnp::Q_PTR) |
-                          ((sc_uint<dnp::PHIT_W>)this_head.src               << dnp::D_PTR) |
-                          ((sc_uint<dnp::PHIT_W>)THIS_ID                     << dnp::S_PTR) |
+                          ((sc_uint<dnp::PHIT_W>)resp_dst                    << dnp::D_PTR) |
+                          ((sc_uint<dnp::PHIT_W>)resp_src                    << dnp::S_PTR) |
                           ((sc_uint<dnp::PHIT_W>)0                        << dnp::V_PTR) ;
       temp_flit.data[1] = ((sc_uint<dnp::PHIT_W>)(this_head.addr_part) << dnp::ace::rresp::AP_PTR) |
                           ((sc_uint<dnp::PHIT_W>)this_head.len         << dnp::ace::rresp::LE_PTR) |
@@ -301,7 +313,7 @@ SC_MODULE(ace_slave_if) {
           this_resp = r_in.Pop();
           duth_fun<ace5_::Data , cfg::RD_LANES>::assign_ac2char(data_build_tmp , this_resp.data);
           last_tmp = this_resp.last;
-          resp_tmp = this_resp.resp;
+          resp_tmp = this_resp.resp | this_head.c_resp;
         }
         
         // Convert AXI Beats to flits
@@ -16,13 +16,15 @@
 #include "../include/axi4_configs_extra.h"
 #include "../include/flit_ace.h"
 #include "../include/duth_fun.h"
+#include "../include/addr_dec.h"
+#include "../include/home_sel.h"
 
 #define LOG_MAX_OUTS 8
 
 #define INIT_S1(n)   n{#n}
 
 // --- Helping Data structures --- //
-template <typename cfg>
+template <typename cfg, unsigned HOME_SEL=HOME_SEL_LINE>
 SC_MODULE(acelite_master_if) {
   typedef typename ace::ace5<axi::cfg::ace> ace5_;
   typedef typename axi::AXI4_Encoding       enc_;
@@ -133,7 +135,7 @@ SC_MODULE(acelite_master_if) {
         bool is_coherent = (this_req.snoop > 0) || ((this_req.snoop ==0) && (this_req.domain.xor_reduce()));
         
         // resolve address to node-id
-        sc_uint<dnp::D_W> this_dst = is_coherent ? (cfg::SLAVE_NUM+cfg::ALL_MASTER_NUM) : addr_lut_rd(this_req.addr);
+        sc_uint<dnp::D_W> this_dst = is_coherent ? home_lut(this_req.addr) : addr_lut_rd(this_req.addr);
         // Check reorder conditions for received TID.
         bool          may_reorder = (sel_entry.sent>0) && (sel_entry.dst_last != this_dst);
         // In case of possible reordering wait_for has the number of transactions
@@ -311,7 +313,7 @@ SC_MODULE(acelite_master_if) {
                                (this_req.snoop == 1);
         
         // resolve address to node-id
-        sc_uint<dnp::D_W> this_dst = pass_thru_home ? (cfg::SLAVE_NUM+cfg::ALL_MASTER_NUM) : addr_lut_wr(this_req.addr);
+        sc_uint<dnp::D_W> this_dst = pass_thru_home ? home_lut(this_req.addr) : addr_lut_wr(this_req.addr);
         
         // Check reorder conditions for this TID.
         //   In an ordered NoC reorder may occur when there are outstanding trans towards different destinations
@@ -485,17 +487,17 @@ SC_MODULE(acelite_master_if) {
   
   // Memory map resolving 
   inline unsigned char addr_lut_rd(const ace5_::Addr addr) {
-    for (int i=0; i<2; ++i) {
-      if (addr>=addr_map[i][0].read() && addr <= addr_map[i][1].read()) return i;
-    }
-    return 0; // Or send 404
+    return addr_dec<cfg::SLAVE_NUM>::get(addr, addr_map);
+  };
+  
+  // Coherent transactions resolve to the HOME of their cache line. HOMEs follow the masters in the Node IDs
+  inline unsigned char home_lut(const ace5_::Addr addr) {
+    return cfg::SLAVE_NUM + cfg::ALL_MASTER_NUM +
+           home_sel<cfg::HOME_NUM, HOME_SEL, nvhls::log2_ceil<(ace5_::C_CACHE_WIDTH>>3)>::val>::get(addr, addr_lut_rd(addr));
   };
   
   inline unsigned char addr_lut_wr(const ace5_::Addr addr) {
-    for (int i=0; i<2; ++i) {
-      if (addr>=addr_map[i][0].read() && addr <= addr_map[i][1].read()) return i;
-    }
-    return 0; // Or send 404
+    return addr_dec<cfg::SLAVE_NUM>::get(addr, addr_map);
   };
   
 }; // End of Master-IF module
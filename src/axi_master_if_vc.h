@@ -16,6 +16,8 @@
 
 #include "./include/axi4_configs_extra.h"
 #include "./include/duth_fun.h"
+#include "./include/src_route.h"
+#include "./include/qos_sel.h"
 
 #define LOG_MAX_OUTS 8
 
@@ -57,7 +59,9 @@ struct order_info {
 // The interface gets the Requests and independently packetize and send them into the network
 // The Responses are getting depacketized into a seperate thread and are fed back to the MASTER
 // Thus Master interface comprises of 4 distinct/parallel blocks WR/RD pack and WR/RD depack
-template <typename cfg>
+// src_rt : The source route policy (see src_route.h). sr_none leaves routing to the routers
+// qos_t  : The QoS policy of the requests (see qos_sel.h). qos_none sends every request at level 0
+template <typename cfg, typename src_rt=sr_none, typename qos_t=qos_none>
 SC_MODULE(axi_master_if_vc) {
   typedef typename axi::axi4<axi::cfg::standard_duth> axi4_;
   typedef typename axi::AXI4_Encoding                 enc_;
@@ -124,6 +128,7 @@ SC_MODULE(axi_master_if_vc) {
     rd_trans_fin  (2),
     wr_trans_fin  (2)
   {
+    NVHLS_ASSERT_MSG(!src_rt::EN || ((cfg::RREQ_PHITS>3) && (cfg::WREQ_PHITS>3)), "Source routing requires a free last phit at the request heads.");
     SC_THREAD(rd_req_pack_job);
     sensitive << clk.pos();
     async_reset_signal_is(rst_n, false);
@@ -178,6 +183,7 @@ SC_MODULE(axi_master_if_vc) {
         // Depending the reordering scheme
         // 0 : all in-flight transactions must be to the same destination
         // 1 : all in-flight transactions of the SAME ID, must be to the same destination
+        // 2 : a single in-flight transaction per ID. The network may reorder packets (e.g. adaptive routing)
         sc_uint<dnp::D_W> this_dst = addr_lut_rd(this_req.addr);
         sc_uint<cfg::VCS> this_vc = 0; //this_req.id.to_uint()==0 ? 0 : 1;
   
@@ -199,7 +205,7 @@ SC_MODULE(axi_master_if_vc) {
           // Get info about the outstanding transactions the received request's TID
           outs_table_entry      sel_entry   = rd_out_table[this_req.id.to_uint()];
   
-          bool                  may_reorder = (sel_entry.sent>0) && (sel_entry.dst_last != this_dst);
+          bool                  may_reorder = (sel_entry.sent>0) && ((cfg::ORD_SCHEME==2) || (sel_entry.dst_last != this_dst));
           sc_uint<LOG_MAX_OUTS> wait_for    =  sel_entry.sent;
           
           // Poll for Finished transactions until no longer reordering is possible.
@@ -229,7 +235,7 @@ SC_MODULE(axi_master_if_vc) {
         tmp_flit.data[0] = ((sc_uint<dnp::PHIT_W>)0                     << dnp::req::REORD_PTR) |
                            ((sc_uint<dnp::PHIT_W>)this_req.id               << dnp::req::ID_PTR ) |
                            ((sc_uint<dnp::PHIT_W>)dnp::PACK_TYPE__RD_REQ << dnp::T_PTR      ) |
-                           ((sc_uint<dnp::PHIT_W>) 0                     << dnp::Q_PTR      ) |
+                           ((sc_uint<dnp::PHIT_W>)qos_t::get(this_req)   << dnp::Q_PTR      ) |
                            ((sc_uint<dnp::PHIT_W>)this_dst                   << dnp::D_PTR      ) |
                            ((sc_uint<dnp::PHIT_W>)THIS_ID                    << dnp::S_PTR      ) ;
         
@@ -240,6 +246,8 @@ SC_MODULE(axi_master_if_vc) {
                            ((sc_uint<dnp::PHIT_W>)this_req.size                     << dnp::req::SZ_PTR ) |
                            ((sc_uint<dnp::PHIT_W>)(this_req.addr >> dnp::AL_W) << dnp::req::AH_PTR ) ;
         
+        if (src_rt::EN) tmp_flit.set_sr(src_rt::route(THIS_ID.read(), this_dst, dnp::PACK_TYPE__RD_REQ));
+        
         // send header flit to NoC
         while (credits_avail[this_vc]==0) {
           sc_uint<dnp::ID_W> tid_fin;
@@ -409,6 +417,7 @@ SC_MODULE(axi_master_if_vc) {
         // Depending the reordering scheme
         // 0 : all in-flight transactions must be to the same destination
         // 1 : all in-flight transactions of the SAME ID, must be to the same destination
+        // 2 : a single in-flight transaction per ID. The network may reorder packets (e.g. adaptive routing)
         
         sc_uint<dnp::D_W> this_dst = addr_lut_wr(this_req.addr);
         sc_uint<cfg::VCS> this_vc = 0; // Requests on VC 0
@@ -429,7 +438,7 @@ SC_MODULE(axi_master_if_vc) {
           out_dst = this_dst;
         } else {
           outs_table_entry sel_entry = wr_out_table[this_req.id.to_uint()];
-          bool may_reorder   = (sel_entry.sent>0) && (sel_entry.dst_last != this_dst);
+          bool may_reorder   = (sel_entry.sent>0) && ((cfg::ORD_SCHEME==2) || (sel_entry.dst_last != this_dst));
           sc_uint<LOG_MAX_OUTS> wait_for =  sel_entry.sent; // Counts outstanding transactions to wait for
           // Poll Finished transactions until no longer reorder is possible.
           while(may_reorder  || (wr_credits_avail[this_vc]==0)) {
@@ -458,7 +467,7 @@ SC_MODULE(axi_master_if_vc) {
         tmp_mule_flit.data[0] = ((sc_uint<dnp::PHIT_W>)0                           << dnp::req::REORD_PTR) |
                                 ((sc_uint<dnp::PHIT_W>)this_req.id                 << dnp::req::ID_PTR)  |
                                 ((sc_uint<dnp::PHIT_W>)dnp::PACK_TYPE__WR_REQ  << dnp::T_PTR)        |
-                                ((sc_uint<dnp::PHIT_W>)0                       << dnp::Q_PTR)        |
+                                ((sc_uint<dnp::PHIT_W>)qos_t::get(this_req)    << dnp::Q_PTR)        |
                                 ((sc_uint<dnp::PHIT_W>)this_dst                    << dnp::D_PTR)        |
                                 ((sc_uint<dnp::PHIT_W>)THIS_ID                     << dnp::S_PTR)        ;
         
@@ -468,6 +477,8 @@ SC_MODULE(axi_master_if_vc) {
         tmp_mule_flit.data[2] = ((sc_uint<dnp::PHIT_W>)this_req.burst                    << dnp::req::BU_PTR)  |
                                 ((sc_uint<dnp::PHIT_W>)this_req.size                     << dnp::req::SZ_PTR)  |
                                 ((sc_uint<dnp::PHIT_W>)(this_req.addr >> dnp::AL_W) << dnp::req::AH_PTR)  ;
+        
+        if (src_rt::EN) tmp_mule_flit.set_sr(src_rt::route(THIS_ID.read(), this_dst, dnp::PACK_TYPE__WR_REQ));
                 
         // push header flit to NoC
         //#pragma hls_pipeline_init_interval 1
@@ -14,6 +14,7 @@
 #include "./include/axi4_configs_extra.h"
 #include "./include/flit_axi.h"
 #include "./include/duth_fun.h"
+#include "./include/src_route.h"
 
 #include <axi/axi4.h>
 
@@ -28,6 +29,7 @@ struct rd_trans_info_t {
   sc_uint<dnp::LE_W> len;
   sc_uint<dnp::AP_W> addr_part;
   sc_uint<dnp::REORD_W> reord_tct; // Used for reordering at master
+  sc_uint<dnp::Q_W>  qos;       // The QoS of the request, returned in the response
   
   inline friend std::ostream& operator << ( std::ostream& os, const rd_trans_info_t& info ) {
     os <<"S: "<< info.src /*<<", D: "<< info.dst*/ <<", TID: "<< info.tid <<", Bu: "<< info.burst <<"Si: "<< info.size <<"Le: "<< info.len <<", Ticket: "<<info.reord_tct;
@@ -50,6 +52,7 @@ struct rd_trans_info_t {
     sc_trace(tf, info.len,   name + ".len");
     // Needed only when reordering is supported
     sc_trace(tf, info.reord_tct,   name + ".ticket");
+    sc_trace(tf, info.qos,   name + ".qos");
   }
 #endif
 };
@@ -59,6 +62,7 @@ struct wr_trans_info_t {
   sc_uint<dnp::S_W>  src;
   sc_uint<dnp::ID_W> tid;
   sc_uint<dnp::REORD_W> reord_tct; // Used for reordering at master
+  sc_uint<dnp::Q_W>  qos;       // The QoS of the request, returned in the response
   
   inline friend std::ostream& operator << ( std::ostream& os, const wr_trans_info_t& info ) {
     os <<"S: "<< info.src << ", Id: " << info.tid <<", Ticket: "<<info.reord_tct;
@@ -76,6 +80,7 @@ struct wr_trans_info_t {
     sc_trace(tf, info.src,   name + ".src");
     sc_trace(tf, info.tid,   name + ".tid");
     sc_trace(tf, info.reord_tct,   name + ".ticket");
+    sc_trace(tf, info.qos,   name + ".qos");
   }
 #endif
 };
@@ -85,7 +90,8 @@ struct wr_trans_info_t {
 // The interface gets the Request packets and independently reconstructs the AXI depending the Slave's attributes
 // The Responses are getting packetized into seperate threads and are fed back to the network
 // Thus Slave interface comprises of 4 distinct/parallel blocks WR/RD pack and WR/RD depack
-template <typename cfg>
+// src_rt : The source route policy (see src_route.h). sr_none leaves routing to the routers
+template <typename cfg, typename src_rt=sr_none>
 SC_MODULE(axi_slave_if_vc) {
   typedef typename axi::axi4<axi::cfg::standard_duth> axi4_;
   typedef typename axi::AXI4_Encoding            enc_;
@@ -152,6 +158,7 @@ SC_MODULE(axi_slave_if_vc) {
     wr_trans_init (3),
     wr_trans_fin  (3)
   { 
+    NVHLS_ASSERT_MSG(!src_rt::EN || ((cfg::RRESP_PHITS>2) && (cfg::WRESP_PHITS>1)), "Source routing requires a free last phit at the response heads.");
     SC_THREAD(rd_req_depack_job);
     sensitive << clk.pos();
     async_reset_signal_is(rst_n, false);
@@ -234,6 +241,7 @@ SC_MODULE(axi_slave_if_vc) {
         temp_info.burst     = (flit_rcv.data[2] >> dnp::req::BU_PTR) & ((1<<dnp::BU_W)-1);
         temp_info.addr_part = (flit_rcv.data[1] & ((1<<dnp::AP_W)-1));
         temp_info.reord_tct = (flit_rcv.data[0] >> dnp::req::REORD_PTR) & ((1<<dnp::REORD_W)-1);
+        temp_info.qos       = flit_rcv.get_qos();
   
         NVHLS_ASSERT(((flit_rcv.data[0].to_uint() >> dnp::D_PTR) & ((1<<dnp::D_W)-1)) == (THIS_ID.read().to_uint()));
         
@@ -278,13 +286,15 @@ SC_MODULE(axi_slave_if_vc) {
                           ((sc_uint<dnp::PHIT_W>)this_head.reord_tct         << dnp::rresp::REORD_PTR) |
                           ((sc_uint<dnp::PHIT_W>)this_head.tid               << dnp::rresp::ID_PTR) |
                           ((sc_uint<dnp::PHIT_W>)dnp::PACK_TYPE__RD_RESP  << dnp::T_PTR) |
-                          ((sc_uint<dnp::PHIT_W>)0                        << dnp::Q_PTR) |
+                          ((sc_uint<dnp::PHIT_W>)this_head.qos            << dnp::Q_PTR) |
                           ((sc_uint<dnp::PHIT_W>)this_head.src               << dnp::D_PTR) |
                           ((sc_uint<dnp::PHIT_W>)THIS_ID                     << dnp::S_PTR) ;
       temp_flit.data[1] = ((sc_uint<dnp::PHIT_W>)(this_head.addr_part) << dnp::rresp::AP_PTR) |
                           ((sc_uint<dnp::PHIT_W>)this_head.len         << dnp::rresp::LE_PTR) |
                           ((sc_uint<dnp::PHIT_W>)this_head.size        << dnp::rresp::SZ_PTR) ;
       
+      if (src_rt::EN) temp_flit.set_sr(src_rt::route(THIS_ID.read(), this_head.src, dnp::PACK_TYPE__RD_RESP));
+      
       //#pragma hls_pipeline_init_interval 1
       while (credits_avail[this_vc]==0) {
         cr_t vc_upd;
@@ -438,6 +448,7 @@ SC_MODULE(axi_slave_if_vc) {
         this_info.tid       = orig_tid;
         this_info.src       = req_src;
         this_info.reord_tct = (flit_rcv.data[0] >> dnp::req::REORD_PTR)  & ((1<<dnp::REORD_W)-1);
+        this_info.qos       = flit_rcv.get_qos();
         
         // update bookkeeping vars
         wr_in_flight++;
@@ -574,9 +585,11 @@ SC_MODULE(axi_slave_if_vc) {
                           ((sc_uint<dnp::PHIT_W>)this_head.reord_tct        << dnp::wresp::REORD_PTR )   |
                           ((sc_uint<dnp::PHIT_W>)this_head.tid              << dnp::wresp::ID_PTR )   |
                           ((sc_uint<dnp::PHIT_W>)dnp::PACK_TYPE__WR_RESP << dnp::T_PTR ) |
-                          ((sc_uint<dnp::PHIT_W>)0                       << dnp::Q_PTR ) |
+                          ((sc_uint<dnp::PHIT_W>)this_head.qos              << dnp::Q_PTR ) |
                           ((sc_uint<dnp::PHIT_W>)this_head.src              << dnp::D_PTR ) |
                           ((sc_uint<dnp::PHIT_W>)THIS_ID                    << dnp::S_PTR ) ;
+      
+      if (src_rt::EN) temp_flit.set_sr(src_rt::route(THIS_ID.read(), this_head.src, dnp::PACK_TYPE__WR_RESP));
   
       while (wr_credits_avail[this_vc]==0) {
         cr_t vc_upd;
@@ -49,7 +49,8 @@ public:
     C_PROT_WIDTH  = 3,
     C_RESP_WIDTH  = 5,
     C_CACHE_WIDTH = Cfg::CacheLineWidth,
-    C_DATA_CHAN_WIDTH = Cfg::CacheLineWidth,
+    C_DATA_CHAN_WIDTH = Cfg::dataWidth, // Snoop Data channel is as wide as the data bus
+    C_LINE_BEATS  = (C_CACHE_WIDTH / C_DATA_CHAN_WIDTH), // Snoop Data beats per cache line
   };
   
   typedef typename ace::axi4<Cfg>::Addr Addr;
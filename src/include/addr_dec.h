@@ -0,0 +1,49 @@
+#ifndef __ADDR_DEC_H__
+#define __ADDR_DEC_H__
+
+#include "systemc.h"
+#include "nvhls_assert.h"
+
+// Memory map decoder. Resolves an address to the Slave (i.e. memory channel) that serves it.
+// Every Slave i covers the address region [addr_map[i][0], addr_map[i][1]].
+//   Slaves that declare identical regions form an interleaved group, which must count a power of 2 Slaves.
+//   Within a group, consecutive 2^LOG_INTLV byte chunks rotate over its Slaves in Slave order.
+//   The default 4KB chunk keeps every AXI burst within a single Slave.
+// All regions are compared in parallel and the hit is priority encoded, thus it resolves in a single cycle.
+//   An unmapped address resolves to Slave 0.
+template <unsigned SLAVE_NUM, unsigned LOG_INTLV=12>
+struct addr_dec {
+  template <typename A, typename M>
+  static inline unsigned char get(const A addr, M (&addr_map)[SLAVE_NUM][2]) {
+    bool          hit[SLAVE_NUM];
+    unsigned char rank[SLAVE_NUM]; // Position in the interleaved group
+    unsigned char size[SLAVE_NUM]; // Slaves of the interleaved group
+    #pragma hls_unroll yes
+    for (int i=0; i<SLAVE_NUM; ++i) {
+      hit[i]  = (addr >= addr_map[i][0].read()) && (addr <= addr_map[i][1].read());
+      rank[i] = 0;
+      size[i] = 0;
+      #pragma hls_unroll yes
+      for (int j=0; j<SLAVE_NUM; ++j) {
+        bool same = (addr_map[j][0].read() == addr_map[i][0].read()) && (addr_map[j][1].read() == addr_map[i][1].read());
+        size[i] += same;
+        rank[i] += (same && (j<i));
+      }
+      NVHLS_ASSERT_MSG((size[i] & (size[i]-1)) == 0, "An interleaved group must count a power of 2 Slaves.");
+    }
+
+    unsigned chunk = ((unsigned)addr) >> LOG_INTLV;
+    bool          found = false;
+    unsigned char sel   = 0;
+    #pragma hls_unroll yes
+    for (int i=0; i<SLAVE_NUM; ++i) {
+      if (!found && hit[i] && (rank[i] == (chunk & (size[i]-1)))) {
+        found = true;
+        sel   = i;
+      }
+    }
+    return sel; // Or send 404
+  };
+};
+
+#endif // __ADDR_DEC_H__
@@ -1,7 +1,7 @@
 #ifndef __ARBITERS_HEADER__
 #define __ARBITERS_HEADER__
 
-enum arb_type {FIXED, MATRIX, ROUND_ROBIN, WEIGHTED_RR, DEFICIT_RR, STRATIFIED_RR, PHASE};
+enum arb_type {FIXED, MATRIX, ROUND_ROBIN, WEIGHTED_RR, DEFICIT_RR, STRATIFIED_RR, PHASE, HIER_MATRIX, HIER_RR, PREFIX_RR};
 
 
 template<unsigned SIZE, arb_type ARB_TYPE, unsigned S=0, unsigned DOMAINS=0>
@@ -13,6 +13,42 @@ public:
 };
 
 
+/* FUNCTION: Parallel-Prefix Helpers
+ * -----------------------------------------
+ * Log-depth replacements of the linear request scans. The prefix OR is a
+ * Kogge-Stone network with log2(SIZE) levels of OR gates, and each bit of the
+ * encoded position is an OR tree.
+ */
+template<unsigned SIZE>
+struct arb_prefix {
+  // Bit i is set when any of the bits 0..i of x is set
+  static inline sc_uint<SIZE> or_scan( sc_uint<SIZE> x ) {
+#pragma hls_unroll yes
+    for (unsigned s=1; s<SIZE; s<<=1) x = x | (sc_uint<SIZE>) (x << s);
+    return x;
+  };
+  
+  // The lowest set bit of x, one-hot
+  static inline sc_uint<SIZE> first( sc_uint<SIZE> x ) {
+    return x & (sc_uint<SIZE>) ~((sc_uint<SIZE>) (or_scan(x) << 1));
+  };
+  
+  // The position of the one-hot oh
+  static inline unsigned oh2bin( sc_uint<SIZE> oh ) {
+    unsigned pos = 0;
+#pragma hls_unroll yes
+    for (unsigned b=0; (1u<<b)<SIZE; b++) {
+      sc_uint<SIZE> sel = 0;
+#pragma hls_unroll yes
+      for (unsigned i=0; i<SIZE; i++) sel[i] = (i>>b) & 1;
+      sc_uint<SIZE> hit = oh & sel;
+      if (hit.or_reduce()) pos |= (1u<<b);
+    }
+    return pos;
+  };
+};
+
+
 /* FUNCTION: Fixed Priority Arbiter
  * INPUT:    Array of bools
  * OUTPUT:   Unsigned integer pointer to bit position
@@ -129,7 +165,6 @@ public:
 template<unsigned SIZE>
 class arbiter<SIZE, MATRIX, 0, 0> {
 private:
-  bool mat[SIZE][SIZE];
   bool mat_v2[SIZE][SIZE];
   //sc_uint<SIZE> matrix_reg[SIZE]; // a word reflects a vertical line of the matrix
 
@@ -143,56 +178,21 @@ public:
 #pragma hls_unroll yes
       for (int j=0; j<SIZE; j++) {
         mat_v2[i][j] = (i>j);
-
-        if (i < j) {
-          mat[i][j] = true;
-        }
       }
     }
   }
   
+  // The grant is found in parallel, as below, and encoded by OR trees
   unsigned arbitrate( bool inp[SIZE] ) {
-    
-    bool found = false;
-    
-    unsigned grants = 0;
-
-#pragma hls_unroll yes
-    for (int i=0; i<SIZE; i++) {
-      if (inp[i] && !found) {
-        found = true;
+    sc_uint<SIZE> reqs   = 0;
+    sc_uint<SIZE> grants = 0;
 
 #pragma hls_unroll yes
-        for (int j=0; j<SIZE; j++) {
-          if ( (i < j) && (!mat[i][j] && inp[j])) {
-            found = false;
-          } else {
-            if ( (i > j) && (mat[i][j] && inp[j])) {
-              found = false;
-            }
-          }
-        }
-        if (found) {
-          grants = i;
-        }
-      }
-    }
+    for (int i=0; i<SIZE; i++) reqs[i] = inp[i];
     
-    if (found) {
-      // If a grants is given - change matrix values
-#pragma hls_unroll yes
-      for (int i=0; i<SIZE; i++) {
-        if (i > grants) {
-          mat[grants][i] = false;
-        } else {
-          if (i < grants) {
-            mat[i][grants] = true;
-          }
-        }
-      }
-    }
+    arbitrate(reqs, grants);
     
-    return grants;
+    return arb_prefix<SIZE>::oh2bin(grants);
   };
   
   bool arbitrate(const sc_uint<SIZE> reqs_i, sc_uint<SIZE>&  grants_o) {
@@ -226,256 +226,311 @@ public:
   
 };
 
-/* FUNCTION: Wighted Round Robin Arbiter
- * INPUT:    Array of bools
- * OUTPUT:   Unsigned integer pointer to bit position
+/* FUNCTION: Parallel-Prefix Round Robin Arbiter
+ * INPUT:    Request vector
+ * OUTPUT:   One-hot grant vector
  * -----------------------------------------
- *
+ * The fairness of ROUND_ROBIN, where the inputs above the last grant come
+ * first, but the first request of each segment is found by a prefix OR
+ * instead of a linear scan or a carry chain. Thus the logic depth grows with
+ * log2(SIZE), for wide arbiters.
  */
 template<unsigned SIZE>
-class arbiter<SIZE, WEIGHTED_RR, 0, 0> {
+class arbiter<SIZE, PREFIX_RR, 0, 0> {
 private:
-  bool     Weights[SIZE][SIZE];
-  bool     unvisited[SIZE];
-  unsigned scanCycle;
+  sc_uint<SIZE> priority_therm; // The inputs above the last grant
+
+public:
+  arbiter() {
+    priority_therm = 0;
+  }
   
-  /* FUNCTION: Priority Enforcer
-   * INPUT:    Integer Value
-   * OUTPUT:   Pointer to the least significant
-   *           non zerob bit.
-   * -----------------------------------------
-   *
-   */
-  unsigned priorityEnforcer( unsigned inp ) {
-    
-    unsigned pbit=0;
-    bool found = false;
+  unsigned arbitrate( bool inp[SIZE] ) {
+    sc_uint<SIZE> reqs   = 0;
+    sc_uint<SIZE> grants = 0;
 
 #pragma hls_unroll yes
-    for (int i=0; i<SIZE; i++) {
-      if ( ((inp & 1<<i) >0) && !found ) {
-        found = true;
-        pbit = i;
-      }
-    }
+    for (int i=0; i<SIZE; i++) reqs[i] = inp[i];
     
-    return pbit;
-  }
-
-public:
+    arbitrate(reqs, grants);
+    
+    return arb_prefix<SIZE>::oh2bin(grants);
+  };
   
-  arbiter(){
+  bool arbitrate(const sc_uint<SIZE> reqs_i, sc_uint<SIZE>&  grants_o) {
+    sc_uint<SIZE> req_hp = reqs_i & priority_therm;
+    
+    bool anygrant = reqs_i.or_reduce();
+    grants_o = arb_prefix<SIZE>::first(req_hp.or_reduce() ? req_hp : reqs_i);
+    
+    if (anygrant) priority_therm = arb_prefix<SIZE>::or_scan(grants_o) << 1;
     
-    scanCycle = 1;
+    return anygrant;
+  };
+};
+
+/* FUNCTION: Weighted Round Robin / Deficit Round Robin Arbiters
+ * INPUT:    Request vector
+ * OUTPUT:   One-hot grant vector
+ * -----------------------------------------
+ * Each input holds a credit, charged by one for every grant. The inputs with
+ * credit left are served round robin. When the competing inputs have spent
+ * their credit, a new round gives each input its weight (1 after reset, up to
+ * 2^W_W-1, set at runtime by set_weight), thus the inputs share the bandwidth
+ * by their weights. Requests without credit are still served when no input
+ * with credit competes, and a lone request is served without starting a round.
+ * Thus in a wormhole router, where every flit is granted, a packet is charged
+ * its length as its flits pass.
+ * WRR  : A round resets the credits to the weights, thus a packet longer than
+ *        the remaining credit overshoots its share.
+ * DRR  : A round adds the weights to the credits, thus the overshoot is carried
+ *        as debt (down to -DEBT_MAX) and the bandwidth follows the weights for
+ *        any packet length. Unused credit is capped at the weight.
+ */
+template<unsigned SIZE, bool DEFICIT, unsigned W_W>
+class arbiter_wgt {
+private:
+  static const int      DEBT_MAX = 256; // The longest AXI burst
+  static const unsigned C_W      = ((W_W > 9) ? W_W : 9) + 1;
+  
+  arbiter<SIZE, ROUND_ROBIN> arb;
+  sc_uint<W_W>  weight[SIZE];
+  sc_int<C_W>   credit[SIZE];
+
+public:
+  arbiter_wgt(){
 #pragma hls_unroll yes
     for (int i=0; i<SIZE; i++) {
-      
-      unvisited[i] = true;
-#pragma hls_unroll yes
-      for (int j=0; j<SIZE; j++) {
-        
-        if (j == i)
-          Weights[i][j] = true;
-        else
-          Weights[i][j] = false;
-      }
+      weight[i] = 1;
+      credit[i] = 1;
     }
   }
   
+  // Weights above 2^W_W-1 saturate. A weight of 0 serves the input only when no input of non-zero weight requests.
+  //   The router sets the weights every cycle, thus only a changed weight reloads the credit
+  void set_weight( unsigned i, unsigned w ) {
+    sc_uint<W_W> w_sat = (w < (1<<W_W)) ? w : ((1<<W_W)-1);
+    if (w_sat != weight[i]) credit[i] = (sc_int<C_W>) w_sat;
+    weight[i] = w_sat;
+  };
+  
   unsigned arbitrate( bool inp[SIZE] ) {
-    
-    bool sterCyles[SIZE];
-    bool isSterile;
-    bool found     = false;
-    
-    unsigned pbit;
-    unsigned sterile = 0;;
-    unsigned grants  = 0;
+    sc_uint<SIZE> reqs   = 0;
+    sc_uint<SIZE> grants = 0;
 
 #pragma hls_unroll yes
-    for (int i=0; i<SIZE; i++) {
-      sterCyles[i] = false;
+    for (int i=0; i<SIZE; i++) reqs[i] = inp[i];
+    
+    arbitrate(reqs, grants);
+    
+    return arb_prefix<SIZE>::oh2bin(grants);
+  };
+  
+  bool arbitrate(const sc_uint<SIZE> reqs_i, sc_uint<SIZE>&  grants_o) {
+    sc_uint<SIZE> reqs_cr  = 0;
+    sc_uint<SIZE> reqs_wgt = 0;
+    #pragma hls_unroll yes
+    for (int i=0; i<SIZE; ++i) {
+      reqs_cr[i]  = reqs_i[i] && (credit[i] > 0);
+      reqs_wgt[i] = reqs_i[i] && (weight[i] != 0);
     }
-
-#pragma hls_unroll yes
-    for (int k=0;k<SIZE; k++) { // repeat until a non sterile scan cycle
-      
-      pbit = priorityEnforcer(scanCycle);
-
-#pragma hls_unroll yes
-      for (int i=0; i<SIZE; i++) { // check each input flow
-        
-        if (!found && inp[i] && unvisited[i] && Weights[i][pbit]) {
-          unvisited[i] = false;
-          found = true;
-          grants = i;
-        }
-      }
-      
-      if (!found) { // if no grant was given
-        
-        isSterile = true;
-
-#pragma hls_unroll yes
-        for (int i=0; i<SIZE; i++) { // update unvisited flows
-          
-          if ( !unvisited[i] ) {
-            isSterile = false;
-          }
-          unvisited[i] = true;
-        }
-        
-        if (isSterile) { // update scan cycle avoiding sterile cycles
-          
-          sterCyles[pbit] = true;
-
-#pragma hls_unroll yes
-          for (int i=0; i<SIZE; i++) {
-            if (sterCyles[i] && ((scanCycle | 1<<i)!=scanCycle) ) {
-              sterile = sterile + (1<<i);
-            }
-          }
-        }
-        
-        scanCycle = scanCycle + sterile + 1;
-        if (scanCycle >= ((1<<SIZE)-1) ) {
-          scanCycle = sterile + 1;
-        }
+    
+    // The competing inputs spent their credit, thus a new round starts
+    bool contention = (reqs_i & (reqs_i - 1)) != 0;
+    if (contention && !reqs_cr.or_reduce()) {
+      #pragma hls_unroll yes
+      for (int i=0; i<SIZE; ++i) {
+        if (DEFICIT) credit[i] = (credit[i] > 0) ? (sc_int<C_W>) weight[i] : (sc_int<C_W>) (credit[i] + weight[i]);
+        else         credit[i] = (sc_int<C_W>) weight[i];
+        reqs_cr[i] = reqs_i[i] && (credit[i] > 0);
       }
     }
     
-    return grants;
-  };
-  
-  
-  /* FUNCTION: WRR Arbiter :: setWeights
-   * INPUT:    Array of unsigned weight values
-   * OUTPUT:
-   * -----------------------------------------
-   * Input weight for each flow is given as a
-   * percentage of the bandwidth is asks for.
-   * For example if the value of the weight is 75,
-   * this flow asks for the 75% of the bandwidth.
-   */
-  void setWeights( unsigned inp[SIZE] ) {
+    // Without credit, e.g. a DRR debt not yet repaid, the inputs of non-zero weight are served in Round-Robin
+    sc_uint<SIZE> reqs_nocr = reqs_wgt.or_reduce() ? reqs_wgt : reqs_i;
+    bool anygrant = arb.arbitrate((reqs_cr.or_reduce() ? reqs_cr : reqs_nocr), grants_o);
     
-    unsigned tmp;
-
-#pragma hls_unroll yes
-    for (int i=0; i<SIZE; i++) {
-      
-      tmp = inp[i];
-
-#pragma hls_unroll yes
-      for (int j=0; j<SIZE; j++) {
-        
-        if (tmp >= 100/(1<<(j+1))) {
-          Weights[i][j] = true;
-          tmp = tmp - 100/(1<<(j+1));
-        } else {
-          Weights[i][j] = false;
-        }
+    #pragma hls_unroll yes
+    for (int i=0; i<SIZE; ++i) {
+      if (grants_o[i]) {
+        if (DEFICIT) credit[i] = (credit[i] > -DEBT_MAX) ? (sc_int<C_W>) (credit[i] - 1) : credit[i];
+        else         credit[i] = (credit[i] > 0)         ? (sc_int<C_W>) (credit[i] - 1) : credit[i];
       }
     }
-  }
+    
+    return anygrant;
+  };
 };
 
+// Weights of S bits (4 when S is 0)
+template<unsigned SIZE, unsigned S>
+class arbiter<SIZE, WEIGHTED_RR, S, 0> : public arbiter_wgt<SIZE, false, ((S==0) ? 4 : S)> {
+};
+
+template<unsigned SIZE, unsigned S>
+class arbiter<SIZE, DEFICIT_RR, S, 0> : public arbiter_wgt<SIZE, true, ((S==0) ? 4 : S)> {
+};
 
-/* FUNCTION: Deficit Round Robin Arbiter
+/* FUNCTION: Two-level Hierarchical Arbiter
  * INPUT:    Array of bools
  * OUTPUT:   Unsigned integer pointer to bit position
  * -----------------------------------------
- *
+ * The inputs are split in groups of GROUP. A group arbiter picks one of the
+ * groups with a request, and the input arbiter of that group picks one of its
+ * inputs. Both levels are LVL_TYPE arbiters. Only the winning group updates its
+ * priorities, thus each level stays fair. The logic grows with the group size
+ * and the number of groups instead of SIZE, for high-radix routers.
  */
-template<unsigned SIZE>
-class arbiter<SIZE, DEFICIT_RR, 0, 0> {
+template<unsigned SIZE, arb_type LVL_TYPE, unsigned GROUP>
+class arbiter_2lvl {
 private:
-  unsigned priority;
+  static const unsigned GROUPS = (SIZE+GROUP-1)/GROUP;
   
-  struct flowQueue {
-    unsigned packetSize[5];
-    unsigned maxIndex;
-  };
-  unsigned  D[SIZE];
-  unsigned  Q[SIZE];
-  bool      ActiveList[SIZE];
-  flowQueue F[SIZE];
+  arbiter<GROUPS, LVL_TYPE> arb_grp;
+  arbiter<GROUP , LVL_TYPE> arb_in[GROUPS];
 
 public:
-  arbiter(){
+  arbiter_2lvl(){
+  }
+  
+  unsigned arbitrate( bool inp[SIZE] ) {
+    bool grp_req[GROUPS];
+    bool in_req[GROUPS][GROUP];
 
 #pragma hls_unroll yes
-    for (int i=0; i<SIZE; i++) {
-      ActiveList[i] = false;
-      F[i].maxIndex = 0;
-      D[i] = 0;
-      Q[i] = 30; // maybe a function to set quantum of BW per input
+    for (int g=0; g<GROUPS; g++) {
+      grp_req[g] = false;
+#pragma hls_unroll yes
+      for (int i=0; i<GROUP; i++) {
+        in_req[g][i] = ((g*GROUP+i) < SIZE) && inp[g*GROUP+i];
+        grp_req[g]   = grp_req[g] || in_req[g][i];
+      }
     }
-  }
-  
-  unsigned arbitrate( bool inp[SIZE], unsigned inp_size[SIZE] ) {
-    
-    bool found_hp = false;
-    bool found_lp = false;
     
-    unsigned grant_hp = 0;
-    unsigned grant_lp = 0;
-    unsigned grants   = 0;
-
-
+    unsigned grp_grant = arb_grp.arbitrate(grp_req);
+    unsigned grants    = 0;
 
 #pragma hls_unroll yes
-    for (int i=0; i<SIZE; i++) {
-      
-      // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-      if ( inp[i] && F[i].maxIndex<5) {
-        ActiveList[i] = true;
-        F[i].packetSize[F[i].maxIndex] = inp_size[i];
-        F[i].maxIndex++;
-      }
-      
-      D[i] = ( ActiveList[i] ) ? (D[i] + Q[i]) : 0;
-      // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-      
-      if (i >= priority) {
-        if (F[i].packetSize[0]<=D[i] && ActiveList[i] && !found_hp) {
-          
-          grant_hp = i;
-          found_hp = true;
-        }
-      } else {
-        if (F[i].packetSize[0]<=D[i] && ActiveList[i] && !found_lp) {
-          
-          grant_lp = i;
-          found_lp = true;
-        }
+    for (int g=0; g<GROUPS; g++) {
+      if (g == grp_grant) grants = g*GROUP + arb_in[g].arbitrate(in_req[g]);
+    }
+    
+    return grants;
+  };
+  
+  bool arbitrate(const sc_uint<SIZE> reqs_i, sc_uint<SIZE>&  grants_o) {
+    sc_uint<GROUPS> grp_reqs  = 0;
+    sc_uint<GROUPS> grp_gnts  = 0;
+    sc_uint<GROUP>  in_reqs[GROUPS];
+
+    #pragma hls_unroll yes
+    for (int g=0; g<GROUPS; ++g) {
+      in_reqs[g] = 0;
+      #pragma hls_unroll yes
+      for (int i=0; i<GROUP; ++i) {
+        if ((g*GROUP+i) < SIZE) in_reqs[g][i] = reqs_i[g*GROUP+i];
       }
+      grp_reqs[g] = in_reqs[g].or_reduce();
     }
     
-    grants = (found_hp) ? grant_hp: grant_lp;
+    bool anygrant = arb_grp.arbitrate(grp_reqs, grp_gnts);
     
-    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    grants_o = 0;
+    #pragma hls_unroll yes
+    for (int g=0; g<GROUPS; ++g) {
+      sc_uint<GROUP> in_gnts = 0;
+      if (grp_gnts[g]) arb_in[g].arbitrate(in_reqs[g], in_gnts);
+      #pragma hls_unroll yes
+      for (int i=0; i<GROUP; ++i) {
+        if ((g*GROUP+i) < SIZE) grants_o[g*GROUP+i] = in_gnts[i];
+      }
+    }
     
-    // Update Queue and Deficit Counter for flow i
-    D[grants] = D[grants] - F[grants].packetSize[0];
+    return anygrant;
+  };
+};
+
+/* FUNCTION: Hierarchical Matrix/Round Robin Arbiters
+ * -----------------------------------------
+ * Two-level arbiters with groups of S inputs (8 when S is 0).
+ */
+template<unsigned SIZE, unsigned S>
+class arbiter<SIZE, HIER_MATRIX, S, 0> : public arbiter_2lvl<SIZE, MATRIX, ((S==0) ? 8 : S)> {
+};
+
+template<unsigned SIZE, unsigned S>
+class arbiter<SIZE, HIER_RR, S, 0> : public arbiter_2lvl<SIZE, ROUND_ROBIN, ((S==0) ? 8 : S)> {
+};
+
+/* FUNCTION: QoS Arbiter
+ * INPUT:    Request vector, and the QoS level of each request
+ * OUTPUT:   One-hot grant vector
+ * -----------------------------------------
+ * Strict priority among the QoS levels, where only the requests of the highest
+ * requested level compete in the ARB_C arbiter (e.g. Round Robin), which rotates
+ * among them. As a starvation guard, an input that lost STARVE_LIM arbitrations
+ * since its last grant is served ahead of every level. STARVE_LIM 0 disables the
+ * guard, and up to 255 is allowed. Without EN, ARB_C arbitrates every request.
+ */
+template<unsigned SIZE, class ARB_C, bool EN=true, unsigned QOS_W=3, unsigned STARVE_LIM=16>
+class qos_arbiter {
+private:
+  static const unsigned LEVELS = (1<<QOS_W);
+  
+  ARB_C          arb;
+  unsigned char  lost[SIZE]; // Arbitrations lost since the last grant
+
+public:
+  qos_arbiter(){
 #pragma hls_unroll yes
-    for (int i=0; i<4; i++) {
-      F[grants].packetSize[i] = F[grants].packetSize[i+1];
-    }
-    F[grants].maxIndex--;
+    for (int i=0; i<SIZE; i++) lost[i] = 0;
+  }
+  
+  bool arbitrate(const sc_uint<SIZE> reqs_i, const sc_uint<QOS_W> qos_i[SIZE], sc_uint<SIZE>&  grants_o) {
+    if (!EN) return arb.arbitrate(reqs_i, grants_o);
+    
+    sc_uint<SIZE> reqs_starved = 0;
+    sc_uint<SIZE> reqs_top     = 0;
+    #pragma hls_unroll yes
+    for (int i=0; i<SIZE; ++i) reqs_starved[i] = reqs_i[i] && (STARVE_LIM>0) && (lost[i]>=STARVE_LIM);
     
-    if ( F[grants].maxIndex == 0 ) {
-      ActiveList[grants] = false;
-      D[grants] = 0;
+    // The highest level with a request wins
+    #pragma hls_unroll yes
+    for (int l=0; l<LEVELS; ++l) {
+      sc_uint<SIZE> reqs_lvl = 0;
+      #pragma hls_unroll yes
+      for (int i=0; i<SIZE; ++i) reqs_lvl[i] = reqs_i[i] && (qos_i[i]==l);
+      if (reqs_lvl.or_reduce()) reqs_top = reqs_lvl;
     }
     
-    if (found_hp || found_lp && (D[grants]<F[grants].packetSize[0])) {
-      priority = ((grants + 1) == SIZE) ? 0 : (grants+1);
+    bool anygrant = arb.arbitrate((reqs_starved.or_reduce() ? reqs_starved : reqs_top), grants_o);
+    
+    #pragma hls_unroll yes
+    for (int i=0; i<SIZE; ++i) {
+      if      (grants_o[i])                          lost[i] = 0;
+      else if (reqs_i[i] && (lost[i] < STARVE_LIM))  lost[i]++;
     }
-    // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     
-    return grants;
+    return anygrant;
   };
+  
+  // Runtime weights of a weighted ARB_C (see arbiter_wgt)
+  void set_weight( unsigned i, unsigned w ) {
+    arb.set_weight(i, w);
+  };
+};
+
+// Sets the runtime weights of weighted arbiters. Without EN nothing is set, thus any arbiter is accepted
+template<bool EN>
+struct arb_weights {
+  template<class ARB>
+  static inline void set( ARB& arb, unsigned i, unsigned w ) {arb.set_weight(i, w);};
+};
+
+template<>
+struct arb_weights<false> {
+  template<class ARB>
+  static inline void set( ARB& arb, unsigned i, unsigned w ) {};
 };
 
 #endif // __ARBITERS_HEADER__
@@ -0,0 +1,158 @@
+#ifndef __DAMQ_H__
+#define __DAMQ_H__
+
+#include "systemc.h"
+#include "nvhls_assert.h"
+
+#include "./duth_fun.h"
+#include "./onehot.h"
+#include "./arbiters.h"
+#include "./fifo_queue_oh.h"
+
+// Input buffers of the VC router (rtr_vc), and the credits that the upstream keeps for them.
+//   A buffer holds the flits of every VC of an input. At most a flit is pushed and a flit is popped per cycle.
+
+// Statically partitioned buffer, a FIFO of DEPTH slots per VC
+template <typename T, unsigned VCS, unsigned DEPTH>
+class vc_fifos {
+public:
+  fifo_queue<T, DEPTH>  fifo[VCS];
+
+  inline bool valid(unsigned v) const {return fifo[v].valid();};
+  inline T    peek (unsigned v) const {return fifo[v].peek();};
+
+  inline void update(bool pushed, unsigned push_vc, T& push_val, bool popped, unsigned pop_vc) {
+    if (pushed) fifo[push_vc].push_no_count_incr(push_val);
+    #pragma hls_unroll yes
+    for (unsigned v=0; v<VCS; ++v) {
+      bool this_vc_pushed = pushed && (push_vc==v);
+      bool this_vc_popped = popped && (pop_vc==v);
+      if (this_vc_popped) fifo[v].inc_pop_ptr();
+      fifo[v].set_count(this_vc_pushed, this_vc_popped);
+    }
+  };
+};
+
+// Dynamically Allocated Multi-Queue. The VCs share the SLOTS of a single storage, where each VC is a linked
+//   list of slots and the free slots are a bit mask. A push takes the lowest free slot and a pop frees the
+//   head slot of its VC. The upstream credits (vc_credits) keep RSV slots for each VC and let any VC take the
+//   SHARED slots, thus a busy VC is not limited to its own slots while the others are idle.
+template <typename T, unsigned VCS, unsigned RSV, unsigned SHARED>
+class damq {
+public:
+  static const unsigned SLOTS = VCS*RSV + SHARED;
+  typedef sc_uint< clog2<SLOTS>::val > slot_t;
+
+  T               mem[SLOTS];
+  slot_t          next[SLOTS];   // The next slot of the same VC
+  slot_t          head[VCS];
+  slot_t          tail[VCS];
+  bool            vc_valid[VCS];
+  sc_uint<SLOTS>  slot_free;
+
+  damq() {
+    reset();
+  };
+
+  void reset() {
+    #pragma hls_unroll yes
+    for (unsigned v=0; v<VCS; ++v) {
+      head[v]     = 0;
+      tail[v]     = 0;
+      vc_valid[v] = false;
+    }
+    slot_free = ~((sc_uint<SLOTS>) 0);
+  };
+
+  inline bool valid(unsigned v) const {return vc_valid[v];};
+  inline T    peek (unsigned v) const {return mem[head[v]];};
+
+  inline void update(bool pushed, unsigned push_vc, T& push_val, bool popped, unsigned pop_vc) {
+    NVHLS_ASSERT_MSG(!pushed || slot_free.or_reduce(), "Pushing on FULL!");
+    NVHLS_ASSERT_MSG(!popped || vc_valid[pop_vc], "Popping on EMPTY!");
+    sc_uint<SLOTS> push_oh   = arb_prefix<SLOTS>::first(slot_free);
+    slot_t         push_slot = arb_prefix<SLOTS>::oh2bin(push_oh);
+    slot_t         pop_slot  = 0;
+
+    #pragma hls_unroll yes
+    for (unsigned v=0; v<VCS; ++v) {
+      bool this_vc_pushed = pushed && (push_vc==v);
+      bool this_vc_popped = popped && (pop_vc==v);
+      // The VC is empty after the pop, thus the pushed slot becomes its head
+      bool empty_after    = !vc_valid[v] || (this_vc_popped && (head[v]==tail[v]));
+
+      if (this_vc_popped) {
+        pop_slot = head[v];
+        head[v]  = next[head[v]];
+      }
+      if (this_vc_pushed) {
+        if (empty_after) head[v]       = push_slot;
+        else             next[tail[v]] = push_slot;
+        tail[v] = push_slot;
+      }
+      vc_valid[v] = this_vc_pushed || !empty_after;
+    }
+
+    #pragma hls_unroll yes
+    for (unsigned s=0; s<SLOTS; ++s) {
+      if      (pushed && push_oh[s])  {mem[s] = push_val; slot_free[s] = false;}
+      else if (popped && (pop_slot==s)) slot_free[s] = true;
+    }
+  };
+};
+
+// The input buffer of a VC router. Statically partitioned without SHARED slots, else a DAMQ
+template <typename T, unsigned VCS, unsigned DEPTH, unsigned SHARED>
+struct vc_buffer {
+  typedef damq<T, VCS, DEPTH, SHARED> type;
+};
+
+template <typename T, unsigned VCS, unsigned DEPTH>
+struct vc_buffer<T, VCS, DEPTH, 0> {
+  typedef vc_fifos<T, VCS, DEPTH> type;
+};
+
+// The credits of a downstream input buffer, per VC. Each VC may hold RSV slots, and beyond them it takes
+//   the SHARED slots that are left, when the pool is enabled (i.e. the downstream is a router with a DAMQ).
+//   The downstream returns a credit with the VC of each departing flit, thus the occupancy of each VC
+//   tells whether the returned slot was a shared one.
+template <unsigned VCS, unsigned RSV, unsigned SHARED>
+class vc_credits {
+public:
+  onehot<RSV+SHARED+1>  used[VCS];   // The slots each VC holds
+  onehot<SHARED+1>      shared_used;
+  bool                  pool;
+
+  void reset(bool pool_en) {
+    #pragma hls_unroll yes
+    for (unsigned v=0; v<VCS; ++v) used[v] = onehot<RSV+SHARED+1>(1);
+    shared_used = onehot<SHARED+1>(1);
+    pool        = pool_en && (SHARED>0);
+  };
+
+  // The VC holds at least n slots
+  inline bool holds(unsigned v, unsigned n) const {return ((used[v].val >> n) != 0);};
+
+  inline bool ready(unsigned v) const {return !holds(v, RSV) || (pool && !shared_used.val[SHARED]);};
+
+  inline void update(bool consumed, unsigned cons_vc, bool returned, unsigned ret_vc) {
+    bool shared_cons = false;
+    bool shared_ret  = false;
+    #pragma hls_unroll yes
+    for (unsigned v=0; v<VCS; ++v) {
+      bool cr_cons_this_vc = consumed && (cons_vc==v);
+      bool cr_upd_this_vc  = returned && (ret_vc==v);
+      if (cr_cons_this_vc && (!cr_upd_this_vc)) {
+        shared_cons = shared_cons || holds(v, RSV);
+        used[v].increase();
+      } else if (!cr_cons_this_vc && ( cr_upd_this_vc)) {
+        shared_ret  = shared_ret || holds(v, RSV+1);
+        used[v].decrease();
+      }
+    }
+    if      ( shared_cons && !shared_ret) shared_used.increase();
+    else if (!shared_cons &&  shared_ret) shared_used.decrease();
+  };
+};
+
+#endif // __DAMQ_H__
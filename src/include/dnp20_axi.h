@@ -2,24 +2,40 @@
 #define __DNP20_V0_DEF__
 
 
+// Width of the node IDs, thus a network has up to 2^DNP_NODE_W nodes. May be overridden at compile time,
+//   e.g. -DDNP_NODE_W=6 for an 8x8 mesh. The header fields follow the IDs, and the phit grows to fit the head.
+#ifndef DNP_NODE_W
+  #define DNP_NODE_W 4
+#endif
+
 // Definition of Duth Network Protocol.
 //   Interconnect's internal packetization protocol 
 namespace dnp {
     enum {
-      PHIT_W = 24, // Phit Width
+      PHIT_W = ((16 + 2*DNP_NODE_W) > 24) ? (16 + 2*DNP_NODE_W) : 24, // Phit Width. The head phit needs 16 bits beside the IDs
       
       V_W = 2, // Virtual Channel
-      S_W = 4, // Source
-      D_W = 4, // Destination
+      LH_W = 2, // Lookahead route
+      SR_W = 3, // Source route entry, the output port of a hop
+      S_W = DNP_NODE_W, // Source
+      D_W = DNP_NODE_W, // Destination
       Q_W = 3, // QoS
       T_W = 2, // Type
       
       V_PTR = 0,
+      // The VC travels beside the phits, thus its field carries the lookahead route of the head flit
+      LH_PTR = V_PTR,
       S_PTR = (V_PTR + V_W),
       D_PTR = (S_PTR + S_W),
       Q_PTR = (D_PTR + D_W),
       T_PTR = (Q_PTR + Q_W),
       
+      // The source route occupies the last phit of the head flit
+      SR_HOPS = (PHIT_W / SR_W),
+      
+      // Multicast destinations, a bit per node, up to the 64 bits of sc_uint
+      MCAST_W = ((1<<D_W) < 64) ? (1<<D_W) : 64,
+      
       // AXI RELATED WIDTHS
       ID_W = 4, // AXI Transaction ID
       BU_W = 2, // AXI Burst
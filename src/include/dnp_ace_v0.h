@@ -2,24 +2,41 @@
 #define __DNP_ACE_DEF__
 
 
+// Width of the node IDs, thus a network has up to 2^DNP_NODE_W nodes. May be overridden at compile time.
+//   The header fields follow the IDs, and the phit grows to fit the head.
+#ifndef DNP_NODE_W
+  #define DNP_NODE_W 3
+#endif
+
 // Definition of Duth Network Protocol for ACE network.
 //   Interconnect's internal packetization protocol 
 namespace dnp {
   enum {
-    // !!!! THIS MUST BE 24. 20 is temp for router synth!!!
-    PHIT_W = 24, // Phit Width
+    // The Snoop Request head carries a multicast mask of a bit per Node, but the last. It follows 11 bits and the IDs,
+    //   thus within the 64 bit phit it caps at 53-2*DNP_NODE_W bits, e.g. 41 Nodes with 6 bit IDs.
+    SNP_MC_W = (((1<<DNP_NODE_W)-1) < (53 - 2*DNP_NODE_W)) ? ((1<<DNP_NODE_W)-1) : (53 - 2*DNP_NODE_W),
+    SNP_HEAD_W = 11 + 2*DNP_NODE_W + SNP_MC_W,
+    
+    // !!!! THIS MUST BE AT LEAST 24. 20 is temp for router synth!!!
+    // Phit Width. The Request head needs 18 bits beside the IDs, the Snoop Request head fits the multicast mask
+    PHIT_W = ((SNP_HEAD_W > (18 + 2*DNP_NODE_W)) ? ((SNP_HEAD_W > 24) ? SNP_HEAD_W : 24) :
+                                                   (((18 + 2*DNP_NODE_W) > 24) ? (18 + 2*DNP_NODE_W) : 24)),
 
     V_W = 2, // Virtual Channel
-    S_W = 3, // Source
-    D_W = 3, // Destination
+    S_W = DNP_NODE_W, // Source
+    D_W = DNP_NODE_W, // Destination
     Q_W = 3, // QoS
     T_W = 3, // Type
+    SR_W = 3, // Source route entry. ACE packets are not source routed
 
     V_PTR = 0,
     S_PTR = (V_PTR + V_W),
     D_PTR = (S_PTR + S_W),
     Q_PTR = (D_PTR + D_W),
     T_PTR = (Q_PTR + Q_W),
+    
+    // A bit per node, up to the 64 bits of sc_uint. Snoop Requests carry only the first ace::MC_W bits
+    MCAST_W = ((1<<D_W) < 64) ? (1<<D_W) : 64,
   };
   
   class ace {
@@ -50,6 +67,12 @@ namespace dnp {
       C_PROT_W = 3,
       C_RESP_W = 5,
       C_HAS_DATA_W = 1,
+      
+      // HOME RELATED WIDTHS
+      HID_W = 3, // HOME transaction tag, carried by Snoop Req/Resp
+      MC_W  = SNP_MC_W, // Multicast destinations of Snoop Req, a bit per Node. HOMEs follow the masters, thus the last Node is never snooped
+      DCT_W = 1, // Direct Cache Transfer, the snooped master sends the data to the initiator
+      DMT_W = 1, // Direct Memory Transfer, the Slave sends the data to the initiator
     };
     
     struct req {
@@ -80,6 +103,13 @@ namespace dnp {
         BU_PTR  = SZ_PTR+SZ_W,
         BAR_PTR = BU_PTR+BU_W,
         UNQ_PTR = BAR_PTR+BAR_W,
+        // PHIT #3. Only when RREQ_PHITS>3, for Direct Memory Transfer
+        //   HOME forwards the Read to the Slave, that responds to the initiator
+        DMT_PHIT = 3,
+        
+        DMT_PTR      = 0,
+        DMT_INIT_PTR = DMT_PTR+DMT_W,
+        DMT_RE_PTR   = DMT_INIT_PTR+S_W, // Coherence bits of the Read response (IsShared, PassDirty)
       };
     };
     
@@ -135,6 +165,12 @@ namespace dnp {
     // ACE Extension
     struct creq {
       enum {
+        // PHIT #0
+        HID_PHIT = 0,
+        MC_PHIT  = 0,
+        
+        HID_PTR = T_PTR+T_W,
+        MC_PTR  = HID_PTR+HID_W,
         // PHIT #1
         AL_PHIT  = 1,
         SNP_PHIT = 1,
@@ -147,6 +183,17 @@ namespace dnp {
         
         AH_PTR = 0,
         C_PROT_PTR = AH_PTR+AH_W,
+        // PHIT #3. Only when CREQ_PHITS>3, for Direct Cache Transfer
+        //   Carries the initiator's request to build the Read response at the snooped master
+        RQ_PHIT = 3,
+        
+        DCT_PTR     = 0,
+        DCT_DTY_PTR = DCT_PTR+DCT_W,     // Dirty data may be passed to the initiator
+        RQ_ID_PTR   = DCT_DTY_PTR+DCT_W,
+        RQ_BU_PTR   = RQ_ID_PTR+ID_W,
+        RQ_SZ_PTR   = RQ_BU_PTR+BU_W,
+        RQ_LE_PTR   = RQ_SZ_PTR+SZ_W,
+        RQ_INIT_PTR = RQ_LE_PTR+LE_W,   // The initiator, to receive the Read response
       };
     };
     
@@ -155,9 +202,12 @@ namespace dnp {
         // PHIT #0
         C_RESP_PHIT     = 0,
         C_HAS_DATA_PHIT = 0,
+        HID_PHIT        = 0,
         
         C_RESP_PTR     = T_PTR+T_W,
         C_HAS_DATA_PTR = C_RESP_PTR + C_RESP_W,
+        HID_PTR        = C_HAS_DATA_PTR + C_HAS_DATA_W,
+        DCT_PTR        = HID_PTR + HID_W, // Data got sent directly to the initiator
       };
     };
   }; // class ACE
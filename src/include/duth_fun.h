@@ -100,6 +100,23 @@ struct clog2 { enum { val = 1 + clog2<(x>>1)>::val }; };
 
 template <> struct clog2<1> { enum { val = 1 }; };
 
+//============================================================================//
+//============================ Optional Input Port ===========================//
+//============================================================================//
+// An input port that exists only when EN. Otherwise a plain member that reads
+//   as T(), thus it needs no binding.
+template <bool EN, class T>
+struct opt_in {
+  typedef sc_in<T> type;
+};
+
+template <class T>
+struct opt_in<false, T> {
+  struct type {
+    T read() const {return T();};
+  };
+};
+
 //============================================================================//
 //============ Weighted-Binary to One-Hot conversion (case based) ============//
 //============================================================================//
@@ -270,10 +287,33 @@ sc_uint<8> wb2oh_case (const sc_uint< clog2<8>::val > wb_i) {
 //============================================================================//
 //============================== Mux Container Struct ========================//
 //============================================================================//
+// Up to 8 inputs the muxes are specialized below. Wider muxes are a tree of them, halving the inputs
+//   at each level, where the OR of the upper half's select bits drives a 2:1 mux. Up to 64 inputs.
 template <class T, int SIZE> struct mux {
-  static T mux_oh_case(const sc_uint<SIZE> sel_i, const T data_i[SIZE]);
-  static T mux_oh_case(const onehot<SIZE> sel_i, const T data_i[SIZE]);
-  static T mux_oh_ao(const sc_uint<SIZE> sel_i, const T data_i[SIZE]);
+  static const int LO = SIZE/2;
+  static const int HI = SIZE-LO;
+  
+  static T mux_oh_case(const sc_uint<SIZE> sel_i, const T data_i[SIZE]) {
+    sc_uint<LO> sel_lo = sel_i.range(LO-1, 0);
+    sc_uint<HI> sel_hi = sel_i.range(SIZE-1, LO);
+    T selected_lo = mux<T, LO>::mux_oh_case(sel_lo, data_i);
+    T selected_hi = mux<T, HI>::mux_oh_case(sel_hi, &data_i[LO]);
+    return sel_hi.or_reduce() ? selected_hi : selected_lo;
+  };
+  
+  static T mux_oh_case(const onehot<SIZE> sel_i, const T data_i[SIZE]) {
+    return mux_oh_case(sel_i.val, data_i);
+  };
+  
+  static T mux_oh_ao(const sc_uint<SIZE> sel_i, const T data_i[SIZE]) {
+    T selected = T();
+    #pragma hls_unroll yes
+    for(int i=0; i<SIZE; ++i) {
+      bool cur_sel_bit = (sel_i >> i) & 1;
+      selected = selected | data_i[i].and_mask(cur_sel_bit);
+    }
+    return selected;
+  };
 };
 //============================================================================//
 //======================== One-Hot Multiplexer (case based) ==================//
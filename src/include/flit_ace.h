@@ -3,6 +3,7 @@
 
 #include "systemc.h"
 #include "nvhls_connections.h"
+#include "nvhls_assert.h"
 
 #include "./dnp_ace_v0.h"
 
@@ -20,6 +21,7 @@ struct flit_dnp {
   sc_uint<dnp::PHIT_W> data[PHIT_NUM];
   
   static const int width = 2+(PHIT_NUM*dnp::PHIT_W); // Matchlib Marshaller requirement
+  static const bool HAS_LA = false; // The V field carries the VC, thus no lookahead route (LA_RC)
   
   // helping functions to retrieve flit info (e.g. flit type, source, destination)
 	inline bool performs_rc()   { return ((type == HEAD) || (type == SINGLE)); }
@@ -36,6 +38,14 @@ struct flit_dnp {
   inline sc_uint<dnp::T_W> get_type() const {return ((data[0] >> dnp::T_PTR) & ((1<<dnp::T_W)-1));};
   inline sc_uint<dnp::V_W> get_vc()   const {return ((data[0] >> dnp::V_PTR) & ((1<<dnp::V_W)-1));};
   inline sc_uint<dnp::Q_W> get_qos()   const {return ((data[0] >> dnp::Q_PTR) & ((1<<dnp::Q_W)-1));};
+  // Multicast destinations, a bit per Node. Only valid on the Snoop Request network, where 0 means unicast to dst
+  inline sc_uint<dnp::MCAST_W> get_mcast() const {return ((data[0] >> dnp::ace::creq::MC_PTR) & ((((sc_uint<dnp::MCAST_W>)1)<<dnp::ace::MC_W)-1));};
+  // No lookahead route, thus LA_RC routers reject the type (HAS_LA). Never called
+  inline sc_uint<dnp::V_W> get_la() const {NVHLS_ASSERT_MSG(0, "ACE flits carry no lookahead route."); return 0;};
+  inline void set_la(sc_uint<dnp::V_W> la) {NVHLS_ASSERT_MSG(0, "ACE flits carry no lookahead route.");};
+  // No source routing
+  inline sc_uint<dnp::SR_W> get_sr() const {return 0;};
+  inline void pop_sr() {};
   
   inline void set_dst(sc_uint<dnp::D_W>  dst ) { data[0] = (data[0].range(dnp::PHIT_W-1, dnp::D_PTR+dnp::D_W) << (dnp::D_PTR+dnp::D_W)) |
                                                                 (dst  << dnp::D_PTR) |
@@ -57,6 +67,9 @@ struct flit_dnp {
                                                                 (qos  << dnp::Q_PTR) |
                                                                 (data[0].range(dnp::Q_PTR-1, 0));
   };
+  inline void set_mcast(sc_uint<dnp::MCAST_W> mask) { data[0] = (data[0].range(dnp::ace::creq::MC_PTR-1, 0)) |
+                                                                      (((sc_uint<dnp::PHIT_W>)(mask & ((((sc_uint<dnp::MCAST_W>)1)<<dnp::ace::MC_W)-1))) << dnp::ace::creq::MC_PTR);
+  };
   inline void set_network(
           sc_uint<dnp::S_W>  src,
           sc_uint<dnp::D_W>  dst,
@@ -101,6 +114,51 @@ struct flit_dnp {
                     ((sc_uint<dnp::PHIT_W>)(snoop_req.addr >> dnp::ace::AL_W) << dnp::ace::creq::AH_PTR) ;
   };
   
+  // Direct Memory Transfer. The initiator and the coherence bits, for the Slave to respond on behalf of HOME
+  inline void set_dmt_req (const sc_uint<dnp::S_W> initiator, const sc_uint<dnp::ace::R_RE_W> resp) {
+    if (PHIT_NUM > dnp::ace::req::DMT_PHIT) {
+      this->data[dnp::ace::req::DMT_PHIT] = ((sc_uint<dnp::PHIT_W>) 1         << dnp::ace::req::DMT_PTR     ) |
+                                            ((sc_uint<dnp::PHIT_W>) initiator << dnp::ace::req::DMT_INIT_PTR) |
+                                            ((sc_uint<dnp::PHIT_W>) resp      << dnp::ace::req::DMT_RE_PTR  ) ;
+    }
+  };
+  
+  inline bool is_dmt() const {
+    return (PHIT_NUM > dnp::ace::req::DMT_PHIT) && ((this->data[dnp::ace::req::DMT_PHIT] >> dnp::ace::req::DMT_PTR) & 1);
+  };
+  
+  inline sc_uint<dnp::S_W>        get_dmt_init() const {return (this->data[dnp::ace::req::DMT_PHIT] >> dnp::ace::req::DMT_INIT_PTR) & ((1<<dnp::S_W)-1);};
+  inline sc_uint<dnp::ace::R_RE_W> get_dmt_resp() const {return (this->data[dnp::ace::req::DMT_PHIT] >> dnp::ace::req::DMT_RE_PTR) & ((1<<dnp::ace::R_RE_W)-1);};
+  
+  // Direct Cache Transfer. The initiator and its request, for the snooped master to build the Read response
+  template<typename T>
+  inline void set_dct_req (const T& rd_req, const bool dirty_ok, const sc_uint<dnp::S_W> initiator) {
+    if (PHIT_NUM > dnp::ace::creq::RQ_PHIT) {
+      this->data[dnp::ace::creq::RQ_PHIT] = ((sc_uint<dnp::PHIT_W>) 1            << dnp::ace::creq::DCT_PTR    ) |
+                                            ((sc_uint<dnp::PHIT_W>) dirty_ok     << dnp::ace::creq::DCT_DTY_PTR) |
+                                            ((sc_uint<dnp::PHIT_W>) rd_req.id    << dnp::ace::creq::RQ_ID_PTR  ) |
+                                            ((sc_uint<dnp::PHIT_W>) rd_req.burst << dnp::ace::creq::RQ_BU_PTR  ) |
+                                            ((sc_uint<dnp::PHIT_W>) rd_req.size  << dnp::ace::creq::RQ_SZ_PTR  ) |
+                                            ((sc_uint<dnp::PHIT_W>) rd_req.len   << dnp::ace::creq::RQ_LE_PTR  ) |
+                                            ((sc_uint<dnp::PHIT_W>) initiator    << dnp::ace::creq::RQ_INIT_PTR) ;
+    }
+  };
+  
+  inline bool is_dct() const {
+    return (PHIT_NUM > dnp::ace::creq::RQ_PHIT) && ((this->data[dnp::ace::creq::RQ_PHIT] >> dnp::ace::creq::DCT_PTR) & 1);
+  };
+  
+  template<typename T>
+  inline void get_dct_req (T& rd_req, bool& dirty_ok) const {
+    rd_req.id    = (this->data[dnp::ace::creq::RQ_PHIT] >> dnp::ace::creq::RQ_ID_PTR) & ((1<<dnp::ace::ID_W)-1);
+    rd_req.burst = (this->data[dnp::ace::creq::RQ_PHIT] >> dnp::ace::creq::RQ_BU_PTR) & ((1<<dnp::ace::BU_W)-1);
+    rd_req.size  = (this->data[dnp::ace::creq::RQ_PHIT] >> dnp::ace::creq::RQ_SZ_PTR) & ((1<<dnp::ace::SZ_W)-1);
+    rd_req.len   = (this->data[dnp::ace::creq::RQ_PHIT] >> dnp::ace::creq::RQ_LE_PTR) & ((1<<dnp::ace::LE_W)-1);
+    dirty_ok     = (this->data[dnp::ace::creq::RQ_PHIT] >> dnp::ace::creq::DCT_DTY_PTR) & 1;
+  };
+  
+  inline sc_uint<dnp::S_W> get_dct_init() const {return (this->data[dnp::ace::creq::RQ_PHIT] >> dnp::ace::creq::RQ_INIT_PTR) & ((1<<dnp::S_W)-1);};
+  
   template<typename T>
   inline void set_rd_resp (const T& rd_req) {
     this->data[0] = ((sc_uint<dnp::PHIT_W>) rd_req.burst   << dnp::ace::rresp::BU_PTR) |
@@ -280,6 +338,7 @@ struct flit_ack {
     sc_uint<1>        wack;
     
     static const int width = 2+dnp::S_W+dnp::D_W+1+1; // Matchlib Marshaller requirement
+    static const bool HAS_LA = false; // No lookahead route (LA_RC)
     
     flit_ack(unsigned type_=0, unsigned src_=0, unsigned dst_=0, bool rack_=0, bool wack_=0) :
             type(type_), src(src_), dst(dst_), rack(rack_), wack(wack_)
@@ -297,6 +356,12 @@ struct flit_ack {
     inline sc_uint<dnp::D_W> get_dst()  const {return dst;};
     inline sc_uint<dnp::S_W> get_src()  const {return src;};
     inline sc_uint<dnp::T_W> get_type()  const {return 0;};
+    inline sc_uint<dnp::MCAST_W> get_mcast() const {return 0;}; // ACKs are unicast
+    inline void set_mcast(sc_uint<dnp::MCAST_W> mask) {};
+    inline sc_uint<dnp::V_W> get_la() const {NVHLS_ASSERT_MSG(0, "ACK flits carry no lookahead route."); return 0;}; // Never called, see HAS_LA
+    inline void set_la(sc_uint<dnp::V_W> la) {NVHLS_ASSERT_MSG(0, "ACK flits carry no lookahead route.");};
+    inline sc_uint<dnp::SR_W> get_sr() const {return 0;}; // No source routing
+    inline void pop_sr() {};
     
     inline bool is_rack()  const {return rack;};
     inline bool is_wack()  const {return wack;};
@@ -22,6 +22,7 @@ struct flit_dnp {
   sc_uint<dnp::PHIT_W> data[PHIT_NUM];
   
   static const int width = 2+2+(PHIT_NUM*dnp::PHIT_W); // Matchlib Marshaller requirement
+  static const bool HAS_LA = true; // Carries the lookahead route, for LA_RC routers
   
   // helping functions to retrieve flit info (e.g. flit type, source, destination)
 	inline bool performs_rc()   { return ((type == HEAD) || (type == SINGLE)); }
@@ -38,6 +39,18 @@ struct flit_dnp {
   inline sc_uint<dnp::T_W> get_type() const {return ((data[0] >> dnp::T_PTR) & ((1<<dnp::T_W)-1));};
   inline sc_uint<dnp::V_W> get_vc()   const {return vc;};
   inline sc_uint<dnp::Q_W> get_qos()   const {return ((data[0] >> dnp::Q_PTR) & ((1<<dnp::Q_W)-1));};
+  // AXI packets are unicast, thus no multicast destinations
+  inline sc_uint<dnp::MCAST_W> get_mcast() const {return 0;};
+  inline void set_mcast(sc_uint<dnp::MCAST_W> mask) {};
+  // Lookahead route, the output port at the next router. Only valid on HEAD/SINGLE flits
+  inline sc_uint<dnp::LH_W> get_la() const {return ((data[0] >> dnp::LH_PTR) & ((1<<dnp::LH_W)-1));};
+  inline void set_la(sc_uint<dnp::LH_W> la) { data[0] = (data[0].range(dnp::PHIT_W-1, dnp::LH_PTR+dnp::LH_W) << (dnp::LH_PTR+dnp::LH_W)) |
+                                                            (la << dnp::LH_PTR);
+  };
+  // Source route, at the last phit of the head. The entry of the next hop is at the LSBs
+  inline sc_uint<dnp::SR_W> get_sr() const {return (data[PHIT_NUM-1] & ((1<<dnp::SR_W)-1));};
+  inline void pop_sr() {data[PHIT_NUM-1] = data[PHIT_NUM-1] >> dnp::SR_W;};
+  inline void set_sr(sc_uint<dnp::PHIT_W> route) {data[PHIT_NUM-1] = route;};
   
   inline void set_dst(sc_uint<dnp::D_W>  dst ) { data[0] = (data[0].range(dnp::PHIT_W-1, dnp::D_PTR+dnp::D_W) << (dnp::D_PTR+dnp::D_W)) |
                                                                 (dst  << dnp::D_PTR) |
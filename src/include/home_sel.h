@@ -0,0 +1,45 @@
+#ifndef __HOME_SEL_H__
+#define __HOME_SEL_H__
+
+#include "systemc.h"
+#include "nvhls_int.h"
+
+// HOME selection of a coherent address, when multiple HOME nodes share the coherent space.
+// Every coherent transaction of a cache line must be serialized to the same HOME, thus
+//   the selection depends only on the line address, and all master interfaces must agree on it.
+//   HOME_SEL_LINE   : Cache line interleave. Consecutive lines map to consecutive HOMEs.
+//   HOME_SEL_XOR    : XOR-fold hash. The line address is folded in HOME index wide chunks, which are XORed.
+//                     Spreads the strided patterns that would hit a single HOME with line interleaving.
+//   HOME_SEL_REGION : Region table. The HOME is chosen by the memory region (i.e. Slave) of the address,
+//                     as Slave modulo HOME_NUM, thus a HOME serves whole memory controllers.
+enum HOME_SEL_METHOD {
+  HOME_SEL_LINE   = 0,
+  HOME_SEL_XOR    = 1,
+  HOME_SEL_REGION = 2
+};
+
+template <unsigned HOME_NUM, unsigned METHOD, unsigned LOG_LINE_BYTES, unsigned ADDR_W=32>
+struct home_sel {
+  static const unsigned LOG_HOMES = (HOME_NUM>1) ? nvhls::log2_ceil<HOME_NUM>::val : 1;
+  static const unsigned FOLDS     = (ADDR_W-LOG_LINE_BYTES+LOG_HOMES-1)/LOG_HOMES;
+
+  // mem is the Slave that serves the address, used by the Region method.
+  template <typename A>
+  static inline unsigned char get(const A addr, const unsigned char mem) {
+    if (HOME_NUM<2) return 0;
+
+    sc_uint<ADDR_W> line = ((sc_uint<ADDR_W>)addr) >> LOG_LINE_BYTES;
+    if (METHOD == HOME_SEL_REGION) {
+      return mem % HOME_NUM;
+    } else if (METHOD == HOME_SEL_XOR) {
+      sc_uint<LOG_HOMES> folded = 0;
+      #pragma hls_unroll yes
+      for (unsigned i=0; i<FOLDS; ++i) folded ^= (line >> (i*LOG_HOMES)) & ((1<<LOG_HOMES)-1);
+      return folded.to_uint() % HOME_NUM;
+    } else {
+      return line.to_uint() % HOME_NUM;
+    }
+  };
+};
+
+#endif // __HOME_SEL_H__
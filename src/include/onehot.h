@@ -21,29 +21,16 @@ public:
     sc_trace(tf, oh_val.val, name + ".val");
   }
   
+  // Values out of range select the first position
   template<typename T>
   inline void set(T wb_val) {
-    switch (wb_val) {
-      case 0 : val = (1<<0);
-        break;
-      case 1 : val = (1<<1);
-        break;
-      case 2 : val = (1<<2);
-        break;
-      case 3 : val = (1<<3);
-        break;
-      case 4 : val = (1<<4);
-        break;
-      case 5 : val = (1<<5);
-        break;
-      case 6 : val = (1<<6);
-        break;
-      case 7 : val = (1<<7);
-        break;
-      default : val = (1<<0);;
-        break;
+    sc_uint<N> oh_val = 1;
+    #pragma hls_unroll yes
+    for (unsigned i=1; i<N; ++i) {
+      if (wb_val == i) oh_val = ((sc_uint<N>) 1) << i;
     }
-  }; //(1<<wb_val);};
+    val = oh_val;
+  };
   
   template<unsigned RHS_N>
   inline void set(onehot<RHS_N> oh_val) { val = oh_val.val;};
@@ -85,6 +72,15 @@ public:
   };
 };
 
+// Muxes without a specialization below use the one-hot mux tree
+template <class T, int SIZE> struct mux;
+
+template<unsigned N>
+template<class T>
+T onehot<N>::mux(const T data_i[N] ) {
+  return ::mux<T, N>::mux_oh_case(val, data_i);
+};
+
 template<>
 template<class T>
 T onehot<2>::mux(const T data_i[2] ) {
@@ -0,0 +1,35 @@
+#ifndef __QOS_SEL_H__
+#define __QOS_SEL_H__
+
+#include "systemc.h"
+
+#include "./dnp20_axi.h"
+
+// QoS of the AXI requests, written by the master interfaces in the Q field of the head flit.
+//   Routers with QoS arbitration (see qos_arbiter) serve the higher levels first, and the slave interfaces
+//   return the QoS of a request in its response. A QoS policy provides get(req) of an AXI AR/AW request.
+
+// No QoS. Every request is at level 0
+struct qos_none {
+  template <typename R>
+  static inline sc_uint<dnp::Q_W> get (const R& req) {return 0;};
+};
+
+// A fixed level for every request of the master, e.g. high for a latency critical CPU, low for a bulk DMA
+template <unsigned QOS>
+struct qos_const {
+  template <typename R>
+  static inline sc_uint<dnp::Q_W> get (const R& req) {return QOS;};
+};
+
+// The AxQOS of the request, carried at the 4 LSBs of AxUSER, as Matchlib's AXI payloads have no AxQOS field.
+//   The cfg of the master interface needs aUserWidth of at least 4. The 4-bit AxQOS keeps its Q_W MSBs.
+struct qos_auser {
+  template <typename R>
+  static inline sc_uint<dnp::Q_W> get (const R& req) {
+    sc_uint<4> axqos = req.auser & 0xF;
+    return (axqos >> (4-dnp::Q_W));
+  };
+};
+
+#endif // __QOS_SEL_H__
@@ -0,0 +1,53 @@
+#ifndef __SRC_ROUTE_H__
+#define __SRC_ROUTE_H__
+
+#include "systemc.h"
+#include "nvhls_assert.h"
+
+#include "./dnp20_axi.h"
+
+// Source routes, written by the network interfaces in the head flit for source routed networks (RC_METHOD 11).
+//   A route lists the output port of every hop, SR_W bits each, with the first hop at the LSBs. The last entry
+//   is the ejection port. Each router pops its entry, thus the route needs no per-router state or LUT.
+// A route policy provides EN, and route(src, dst, type) that returns the route of a packet. Policies of
+//   irregular topologies may simply return a precomputed route per source and destination pair.
+
+// No source routing. The routers compute the route
+struct sr_none {
+  static const bool EN = false;
+
+  static inline sc_uint<dnp::PHIT_W> route (sc_uint<dnp::S_W> src, sc_uint<dnp::D_W> dst, sc_uint<dnp::T_W> type) {return 0;};
+};
+
+// XY routes of a 2-D mesh with merged RD/WR Req-Resp, as the XY routing of the routers (RC_METHOD 5).
+//   Node n sits at column n%DIM_X and row n/DIM_X. RD packets eject at port 4 and WR packets at port 5.
+template <unsigned DIM_X>
+struct sr_xy_merge {
+  static const bool EN = true;
+
+  static inline sc_uint<dnp::PHIT_W> route (sc_uint<dnp::S_W> src, sc_uint<dnp::D_W> dst, sc_uint<dnp::T_W> type) {
+    unsigned cur_x = src.to_uint() % DIM_X;
+    unsigned cur_y = src.to_uint() / DIM_X;
+    unsigned dst_x = dst.to_uint() % DIM_X;
+    unsigned dst_y = dst.to_uint() / DIM_X;
+
+    sc_uint<dnp::PHIT_W> rt = 0;
+    bool ejected = false;
+    #pragma hls_unroll yes
+    for (unsigned h=0; h<dnp::SR_HOPS; ++h) {
+      unsigned op;
+      if      (dst_x>cur_x) {op = 1; cur_x++;}
+      else if (dst_x<cur_x) {op = 0; cur_x--;}
+      else if (dst_y>cur_y) {op = 3; cur_y++;}
+      else if (dst_y<cur_y) {op = 2; cur_y--;}
+      else                  {op = (type==dnp::PACK_TYPE__RD_REQ || type==dnp::PACK_TYPE__RD_RESP) ? 4 : 5;}
+
+      if (!ejected) rt |= ((sc_uint<dnp::PHIT_W>)op << (h*dnp::SR_W));
+      ejected = ejected || (op>=4);
+    }
+    NVHLS_ASSERT_MSG(ejected, "The route does not fit in the source route field.");
+    return rt;
+  };
+};
+
+#endif // __SRC_ROUTE_H__
@@ -7,18 +7,26 @@
 #include "./include/duth_fun.h"
 #include "./include/arbiters.h"
 #include "./include/fifo_queue_oh.h"
+#include "./include/damq.h"
 
 #include "nvhls_connections.h"
 
+// VC allocation policies. A packet gets a free VC of its class at every output.
+//   VA_DST : The VC is selected by the destination, among the VCs of the class. Packets towards the same
+//            destination share a VC, thus they are delivered in order, as the AXI interfaces expect.
+//   VA_ANY : Any free VC of the class. Packets of the same flow may overtake each other.
+enum va_policy {VA_DST=0, VA_ANY=1};
+
 // Select In/Out Ports, the type of flit and the Routing Computation calculation function
 // For RC_METHOD: 0-> direct rc 1-> lut, 2-> type, ... , 4-> LUT based routing
 // IN_NUM    : Number of inputs
 // OUT_NUM   : Number of inputs
 // flit_t    : The networks flit type
 // DIM_X      : X Dimension of a 2-D mesh network. Used in XY routing
+// DIM_Y      : Y Dimension of a 2-D torus network. Used in torus routing (last template parameter)
 // NODES      : All possible target nodes of the network. Used in LUT routing
 // VCS        : Number of Virtual Channels
-// BUFF_DEPTH : Input Buffer slots
+// BUFF_DEPTH : Input Buffer slots per VC. With SHARED slots, the slots reserved for each VC
 // RC_METHOD : Routing Computation Algotrithm
 //               - 0 : Direct RC
 //               - 1 : Constant RC    (for mergers)
@@ -26,13 +34,63 @@
 //               - 3 : For single stage NoCs
 //               - 4 : LUT based RC
 //               - 5 : XY routing with merged RD/WR Req-Resp
+//               - 6 : LUT based RC with multicast. A SINGLE flit with a destination mask forks
+//                     to every output that leads to a destination, keeping its VC. The input
+//                     slot and its credit are released after the last copy is sent.
+//               - 7 : Adaptive minimal routing with the West-First turn model, merged RD/WR Req-Resp
+//               - 8 : Adaptive minimal routing with the Odd-Even turn model, merged RD/WR Req-Resp
+//                     Both select among the permitted minimal outputs one with a free VC of the packet's class
+//                     that has credits. Packets to the same destination may be reordered, thus the masters
+//                     must use ORD_SCHEME 2.
+//               - 9 : Fully adaptive minimal routing with an XY escape VC (Duato), merged RD/WR Req-Resp.
+//                     The first VC of each class is its escape VC, that is only allocated towards the XY output.
+//                     The rest of the class are adaptive VCs, allocated towards any minimal output. The head
+//                     selects a minimal output with a free adaptive VC that has credits, else it falls back to
+//                     XY, where it takes an adaptive VC if one frees up, or the escape VC. Requires at least two
+//                     VCs per class, and ORD_SCHEME 2 at the masters.
+//               - 10: Torus XY routing with merged RD/WR Req-Resp, on a DIM_X x DIM_Y torus. A ring is a torus with
+//                     DIM_Y of 1. Each dimension takes its shorter direction over the wrap-around links, East/South
+//                     on ties. Deadlocks in the rings are avoided with datelines. The VCs of each class are split
+//                     in two sets, by the parity of v/VC_CLASSES. A packet travels in set 0, moves to set 1 at the
+//                     wrap-around link of the ring, and returns to set 0 at the turn to the Y dimension.
+//                     Requires at least two VCs per class.
+//               - 11: Source routing. The head flit carries the output port of every hop, written by the
+//                     network interface (see src_route.h). The router pops its entry, thus it needs no routing logic.
 
-// ARB_C      : The arbiter type. Eg MATRIX, ROUND_ROBIN
-template< unsigned int IN_NUM, unsigned int OUT_NUM, typename flit_t, int DIM_X=0, int NODES=1, unsigned VCS=2, unsigned BUFF_DEPTH=3, unsigned RC_METHOD=3, arb_type arbiter_t=MATRIX >
+// ARB_C      : The arbiter type. Eg MATRIX, ROUND_ROBIN, or the two-level HIER_MATRIX, HIER_RR for more than 8 inputs
+// VC_CLASSES : Message classes (e.g. Requests/Responses) that must not share a VC, to avoid protocol deadlocks.
+//              VC v belongs to class v%VC_CLASSES. The default of one VC per class keeps every packet on its VC.
+// VA_POLICY  : VC allocation policy, VA_DST or VA_ANY. With RC_METHOD 9 the mesh outputs follow the escape/adaptive VC split
+// EJ_PORT    : Outputs from EJ_PORT and above eject to network interfaces, which receive a packet at a time,
+//              thus a packet ejects on the first VC of its class (i.e. VC == class).
+// SPEC_SA    : Speculative switch allocation. A packet waiting for VC allocation requests the switch in parallel,
+//              thus its head departs at the same cycle it gets an output VC.
+// VC allocation is a separable input-first stage, ahead of switch allocation. Each input VC requests a free
+//   VC of the output that RC selected (VA1, among the candidate VCs), and each output VC grants one of the
+//   requesting input VCs (VA2). Switch allocation follows at the next cycle. The output VC is released by the tail.
+// With SPEC_SA, the VC that VA1 selected is also requested at SA1/SA2, at a lower priority than the packets that
+//   already hold an output VC. A speculative grant at SA2 is kept only when VA2 granted the same output VC,
+//   otherwise the output stays idle for the cycle and the flit retries, now holding its VC if VA2 granted another.
+// LA_RC      : Lookahead RC, for XY routing (RC_METHOD 5). The head flit carries its output port at this router,
+//              computed by the previous one, thus VC allocation starts without waiting for RC. The route
+//              at the next router is computed in parallel and written in the head, as in router_wh_top.
+// QOS        : QoS aware SA2. The flits of the highest QoS level (the Q field of their head) win the output,
+//              and the arbiter_t arbiter rotates among them. Inputs that keep losing are eventually served.
+// AGE        : Age based SA2. The Q field of the head counts the hops of the packet, as in router_wh_top, and
+//              the oldest flits win the output. Exclusive with QOS.
+// SHARED     : Slots of each input shared by its VCs, beside the BUFF_DEPTH slots of each VC. The input buffer
+//              is then a DAMQ (see damq.h), where the VCs are linked lists over a single storage, thus a busy
+//              VC takes the shared slots instead of stalling on its own. The credits towards the outputs below
+//              EJ_PORT count the shared slots of the downstream router, thus the routers of a network must agree
+//              on BUFF_DEPTH and SHARED. The network interfaces keep to the reserved slots.
+template< unsigned int IN_NUM, unsigned int OUT_NUM, typename flit_t, int DIM_X=0, int NODES=1, unsigned VCS=2, unsigned BUFF_DEPTH=3, unsigned RC_METHOD=3, arb_type arbiter_t=MATRIX,
+          unsigned VC_CLASSES=VCS, unsigned VA_POLICY=VA_DST, unsigned EJ_PORT=OUT_NUM, bool SPEC_SA=false, bool LA_RC=false, int DIM_Y=1, bool QOS=false, bool AGE=false, unsigned SHARED=0 >
 SC_MODULE(rtr_vc) {
 public:
   typedef sc_uint< nvhls::log2_ceil<VCS>::val > cr_t;
   
+  static_assert(!LA_RC || flit_t::HAS_LA, "Lookahead RC requires a flit type that carries the lookahead route.");
+  
   sc_in_clk   clk;
   sc_in<bool> rst_n;
   
@@ -48,14 +106,21 @@ public:
   Connections::In<cr_t>    cr_in[OUT_NUM];
   
   // Internals
-  fifo_queue<flit_t, BUFF_DEPTH>  fifo[IN_NUM][VCS];
-  bool                            out_lock[IN_NUM][VCS];
+  typename vc_buffer<flit_t, VCS, BUFF_DEPTH, SHARED>::type  fifo[IN_NUM];
+  bool                            out_lock[IN_NUM][VCS];        // The packet at the head of the VC got an output VC
   onehot<OUT_NUM>                 out_port_locked[IN_NUM][VCS];
+  cr_t                            out_vc_locked[IN_NUM][VCS];   // The allocated VC of the output
+  sc_uint<dnp::Q_W>               qos_locked[IN_NUM][VCS];      // The QoS of the packet that holds the output VC
+  sc_uint<OUT_NUM>                mc_sent[IN_NUM][VCS]; // Outputs that already got a copy of a multicast flit
   
-  onehot<BUFF_DEPTH+1>        credits[OUT_NUM][VCS];
-  onehot<VCS>                 out_available[OUT_NUM];
-  arbiter<VCS   , arbiter_t>  arb_sa1[IN_NUM];
-  arbiter<IN_NUM, arbiter_t>  arb_sa2[OUT_NUM];
+  vc_credits<VCS, BUFF_DEPTH, SHARED>  credits[OUT_NUM];
+  onehot<VCS>                 out_available[OUT_NUM];       // Output VCs not allocated to a packet
+  arbiter<VCS       , arbiter_t>  arb_va1[IN_NUM][VCS];
+  arbiter<IN_NUM*VCS, arbiter_t>  arb_va2[OUT_NUM][VCS];
+  typedef arbiter<VCS, arbiter_t>                                                    sa1_arb_t;
+  typedef qos_arbiter<IN_NUM, arbiter<IN_NUM, arbiter_t>, (QOS || AGE), dnp::Q_W>  sa2_arb_t;
+  sa1_arb_t  arb_sa1[IN_NUM];
+  sa2_arb_t  arb_sa2[OUT_NUM];
   
   // Constructor
   SC_HAS_PROCESS(rtr_vc);
@@ -64,6 +129,13 @@ public:
     :
     sc_module(name_)
   {
+    NVHLS_ASSERT_MSG((VC_CLASSES>0) && (VC_CLASSES<=VCS) && ((VCS%VC_CLASSES)==0), "VCs must be a multiple of the VC classes.");
+    NVHLS_ASSERT_MSG(!LA_RC || RC_METHOD==5, "Lookahead RC requires XY routing.");
+    NVHLS_ASSERT_MSG(!(QOS && AGE), "QoS and age based arbitration share the Q field.");
+    NVHLS_ASSERT_MSG((RC_METHOD!=9) || ((VCS/VC_CLASSES)>1), "Escape VC routing requires an adaptive VC per class.");
+    NVHLS_ASSERT_MSG((RC_METHOD!=10) || ((VCS/VC_CLASSES)>1), "Torus routing requires two VCs per class, for the dateline.");
+    NVHLS_ASSERT_MSG((RC_METHOD!=11) || (OUT_NUM<=(1<<dnp::SR_W)), "The outputs exceed the source route entry.");
+    NVHLS_ASSERT_MSG((RC_METHOD!=6) || (NODES<=dnp::MCAST_W), "The nodes exceed the multicast mask.");
     SC_THREAD(router_job);
     sensitive << clk.pos();
     async_reset_signal_is(rst_n, false);
@@ -75,6 +147,18 @@ public:
     onehot<VCS>  sa1_grants[IN_NUM];
     
     flit_t flit_to_xbar[IN_NUM];
+    cr_t   vc_to_xbar[IN_NUM];   // The output VC of the flit that won SA1
+    bool   mc_to_xbar[IN_NUM];
+    bool   spec_to_xbar[IN_NUM]; // The input requests SA2 speculatively
+    bool   spec_fail[IN_NUM];    // ...and won SA2 without the output VC, thus the grant is dropped
+    sa1_arb_t arb_sa1_prev[IN_NUM]; // The SA1 priorities before a speculative grant, restored if it fails
+    sc_uint<dnp::Q_W> qos_to_xbar[IN_NUM];
+    
+    // VC allocation. The output and the candidate VCs each input VC requests
+    bool             va_req[IN_NUM][VCS];
+    onehot<OUT_NUM>  va_port[IN_NUM][VCS];
+    sc_uint<VCS>     va1_gnt[IN_NUM][VCS];
+    sc_uint<IN_NUM*VCS> va2_gnt[OUT_NUM][VCS];
     
     // The request and grants of the Inputs/Outputs
     onehot<OUT_NUM> req_sa2_per_i[IN_NUM];
@@ -83,13 +167,22 @@ public:
     onehot<IN_NUM>  gnt_sa2_per_o[OUT_NUM];
     onehot<OUT_NUM> gnt_sa2_per_i[IN_NUM];
     
+    // Multicast flits at the head of each VC, and their required outputs
+    bool             is_mcast[IN_NUM][VCS];
+    sc_uint<OUT_NUM> mc_ports[IN_NUM][VCS];
+    
     // Reset per input state
     #pragma hls_unroll yes
     per_i_rst:for (unsigned char i=0; i<IN_NUM; ++i) {
       data_in[i].Reset();
       cr_out[i].Reset();
       #pragma hls_unroll yes
-      for(unsigned v=0; v<VCS; ++v) out_lock[i][v] = false;
+      for(unsigned v=0; v<VCS; ++v) {
+        out_lock[i][v]      = false;
+        out_vc_locked[i][v] = 0;
+        qos_locked[i][v]    = 0;
+        mc_sent[i][v]       = 0;
+      }
     }
     // Reset per output state
     #pragma hls_unroll yes
@@ -99,8 +192,8 @@ public:
       #pragma hls_unroll yes
       for(unsigned v=0; v<VCS; ++v) {
         out_available[j].val[v] = true;
-        credits[j][v] = onehot<BUFF_DEPTH+1>(1<<BUFF_DEPTH);
       }
+      credits[j].reset(j<EJ_PORT);
     }
     
     // Post Reset
@@ -141,7 +234,7 @@ public:
         // Check Credits
         #pragma hls_unroll yes
         for (int v = 0; v < VCS; ++v) {
-          out_ready[j][v] = (credits[j][v].is_ready());
+          out_ready[j][v] = credits[j].ready(v);
         }
       }
       
@@ -150,46 +243,123 @@ public:
       input_prep : for (int i = 0; i < IN_NUM; ++i) {
         onehot<VCS>      req_sa1;
         onehot<OUT_NUM>  port_req_oh[VCS];
+        onehot<VCS>      req_sa1_spec(0);
+        cr_t             va1_vc[VCS];      // The VC that VA1 selected, requested speculatively
         
         // prepare requests of each VC, to content in SA1
         #pragma hls_unroll yes
         vc_prep : for (unsigned v=0; v<VCS; ++v) {
-          vc_hol_flit[i][v] = fifo[i][v].peek();
+          vc_hol_flit[i][v] = fifo[i].peek(v);
           
-          // Depending the Flit type the input selects an output port to request.
-          // The required output gets stored to be used by the rest of the flits.
-          if (out_lock[i][v]) {
-            port_req_oh[v].set(out_port_locked[i][v]);
-          } else {
-            // Route Computation
-            unsigned char current_op;
-            if      (RC_METHOD==0) { current_op = do_rc_direct(vc_hol_flit[i][v].get_dst());} // returns the node ID
-            else if (RC_METHOD==1) { current_op = do_rc_const();} // returns 0. Used for mergers
-            else if (RC_METHOD==2) { current_op = do_rc_type(vc_hol_flit[i][v].get_type());} // Return 0/1 depending the type. used for splitters
-            else if (RC_METHOD==3) { current_op = do_rc_common(vc_hol_flit[i][v].get_dst(),vc_hol_flit[i][v].get_type());}
-            else if (RC_METHOD==4) { current_op = do_rc_lut(vc_hol_flit[i][v].get_dst());}
-            else if (RC_METHOD==5) { current_op = do_rc_xy_merge(vc_hol_flit[i][v].get_dst(), vc_hol_flit[i][v].get_type());}
-            else                   { NVHLS_ASSERT_MSG(0, "Wrong Routing method selected.");}
-            
-            port_req_oh[v].set(current_op);
-            out_port_locked[i][v].set(port_req_oh[v]);
+          // Route Computation of the packet at the head, while it waits for an output VC
+          unsigned char current_op;
+          if      (RC_METHOD==0) { current_op = do_rc_direct(vc_hol_flit[i][v].get_dst());} // returns the node ID
+          else if (RC_METHOD==1) { current_op = do_rc_const();} // returns 0. Used for mergers
+          else if (RC_METHOD==2) { current_op = do_rc_type(vc_hol_flit[i][v].get_type());} // Return 0/1 depending the type. used for splitters
+          else if (RC_METHOD==3) { current_op = do_rc_common(vc_hol_flit[i][v].get_dst(),vc_hol_flit[i][v].get_type());}
+          else if (RC_METHOD==4) { current_op = do_rc_lut(vc_hol_flit[i][v].get_dst());}
+          else if (RC_METHOD==5) {
+            if (LA_RC && i<4) current_op = do_rc_la(vc_hol_flit[i][v].get_la(), vc_hol_flit[i][v].get_type(), i); // Precomputed upstream
+            else              current_op = do_rc_xy_merge(vc_hol_flit[i][v].get_dst(), vc_hol_flit[i][v].get_type());
+          }
+          else if (RC_METHOD==6) { current_op = do_rc_lut(vc_hol_flit[i][v].get_dst());} // Unicast, else the multicast outputs are used
+          else if (RC_METHOD==7 || RC_METHOD==8 || RC_METHOD==9) {
+            // Until it gets an output VC, the head re-routes every cycle towards the mesh outputs with a free VC of its class that has credits
+            //   With escape VC routing only the adaptive VCs count, as the escape VC is not available at every minimal output
+            sc_uint<4> free_dirs = 0;
+            #pragma hls_unroll yes
+            for (int j=0; j<OUT_NUM; ++j) {
+              #pragma hls_unroll yes
+              for (unsigned w=0; w<VCS; ++w) {
+                bool w_usable = ((w%VC_CLASSES)==(v%VC_CLASSES)) && ((RC_METHOD!=9) || (w>=VC_CLASSES));
+                if ((j<4) && out_available[j][w] && out_ready[j][w] && w_usable) free_dirs[j] = 1;
+              }
+            }
+            current_op = do_rc_adaptive(vc_hol_flit[i][v].get_dst(), vc_hol_flit[i][v].get_src(), vc_hol_flit[i][v].get_type(), free_dirs);
           }
+          else if (RC_METHOD==10) { current_op = do_rc_torus(vc_hol_flit[i][v].get_dst(), vc_hol_flit[i][v].get_type());}
+          else if (RC_METHOD==11) { current_op = vc_hol_flit[i][v].get_sr();} // Precomputed at the source
+          else                   { NVHLS_ASSERT_MSG(0, "Wrong Routing method selected.");}
+          va_port[i][v].set(current_op);
           
-          // The required output port must be also Ready and or available.
-          onehot<VCS> req_out_ready_vcs = mux<onehot<VCS>, OUT_NUM>::mux_oh_case(port_req_oh[v], out_ready);
-          onehot<VCS> req_out_avail_vcs = mux<onehot<VCS>, OUT_NUM>::mux_oh_case(port_req_oh[v], out_available);
+          // The next router finds its entry at the LSBs. Cleared after ejecting
+          if ((RC_METHOD==11) && vc_hol_flit[i][v].performs_rc()) vc_hol_flit[i][v].pop_sr();
           
-          bool req_out_ready = req_out_ready_vcs[v];
-          bool req_out_avail = req_out_avail_vcs[v];
-  
-          req_sa1[v] = (fifo[i][v].valid() && req_out_ready && (out_lock[i][v] || req_out_avail));
+          // The route of the next router, in parallel to allocation. Cleared when ejecting
+          if (LA_RC && vc_hol_flit[i][v].performs_rc()) {
+            vc_hol_flit[i][v].set_la((current_op<4) ? do_la_xy_merge(vc_hol_flit[i][v].get_dst(), vc_hol_flit[i][v].get_type(), current_op) : (sc_uint<2>) 0);
+          }
+          
+          // A multicast flit requests every output that has not yet received its copy
+          is_mcast[i][v] = (RC_METHOD==6) && fifo[i].valid(v) && (vc_hol_flit[i][v].get_mcast() != 0);
+          mc_ports[i][v] = is_mcast[i][v] ? do_rc_lut_mcast(vc_hol_flit[i][v].get_mcast()) : (sc_uint<OUT_NUM>) 0;
+          NVHLS_ASSERT_MSG(!is_mcast[i][v] || vc_hol_flit[i][v].is_single(), "Only SINGLE flits can be multicast.");
+          
+          // VA1 : A new packet requests a free VC of its class at the output, as the policy allows
+          onehot<VCS>  req_out_avail_vcs = mux<onehot<VCS>, OUT_NUM>::mux_oh_case(va_port[i][v], out_available);
+          bool         va_need = fifo[i].valid(v) && !out_lock[i][v] && !is_mcast[i][v];
+          sc_uint<VCS> va_cand = 0;
+          #pragma hls_unroll yes
+          for (unsigned w=0; w<VCS; ++w) {
+            va_cand[w] = va_need && req_out_avail_vcs[w] && va_allowed(v, w, current_op, vc_hol_flit[i][v].get_dst(), vc_hol_flit[i][v].get_type(), vc_hol_flit[i][v].get_src());
+          }
+          // The escape VC is kept as the last resort, when no adaptive VC is free
+          if (RC_METHOD==9) {
+            sc_uint<VCS> va_cand_adapt = 0;
+            #pragma hls_unroll yes
+            for (unsigned w=VC_CLASSES; w<VCS; ++w) va_cand_adapt[w] = va_cand[w];
+            if (va_cand_adapt!=0) va_cand = va_cand_adapt;
+          }
+          va1_gnt[i][v] = 0;
+          va_req[i][v]  = arb_va1[i][v].arbitrate(va_cand, va1_gnt[i][v]);
+          
+          // Speculative SA1, for the VC that VA1 selected
+          va1_vc[v] = 0;
+          #pragma hls_unroll yes
+          for (unsigned w=0; w<VCS; ++w) if (va1_gnt[i][v][w]) va1_vc[v] = w;
+          onehot<VCS> va_out_ready_vcs = mux<onehot<VCS>, OUT_NUM>::mux_oh_case(va_port[i][v], out_ready);
+          req_sa1_spec[v] = SPEC_SA && va_req[i][v] && va_out_ready_vcs[va1_vc[v]];
+          
+          // SA1 : The packets that hold an output VC, request their output when it has credits for it
+          if (is_mcast[i][v]) {
+            #pragma hls_unroll yes
+            for (int j=0; j<OUT_NUM; ++j) {
+              port_req_oh[v][j] = mc_ports[i][v][j] && !mc_sent[i][v][j] && out_ready[j][v] && out_available[j][v];
+            }
+            req_sa1[v] = port_req_oh[v].or_reduce();
+          } else {
+            port_req_oh[v].set(out_port_locked[i][v]);
+            onehot<VCS> req_out_ready_vcs = mux<onehot<VCS>, OUT_NUM>::mux_oh_case(port_req_oh[v], out_ready);
+            
+            req_sa1[v] = (fifo[i].valid(v) && out_lock[i][v] && req_out_ready_vcs[out_vc_locked[i][v]]);
+          }
         }
         
         // Arbitrate amonng the VCs and select the winner to access SA2 and output MUX
-        bool any_sa1_gnt = arb_sa1[i].arbitrate(req_sa1.val, sa1_grants[i].val);
+        //   Speculative requests compete only when no VC holds an output VC
+        spec_to_xbar[i]  = SPEC_SA && !req_sa1.or_reduce();
+        spec_fail[i]     = false;
+        if (SPEC_SA) arb_sa1_prev[i] = arb_sa1[i];
+        bool any_sa1_gnt = arb_sa1[i].arbitrate((spec_to_xbar[i] ? req_sa1_spec.val : req_sa1.val), sa1_grants[i].val);
         
         flit_to_xbar[i]  = mux<flit_t, VCS>::mux_oh_case(sa1_grants[i], vc_hol_flit[i]);
-        req_sa2_per_i[i] = mux<onehot<OUT_NUM>, VCS>::mux_oh_case(sa1_grants[i], port_req_oh).and_mask(any_sa1_gnt);
+        mc_to_xbar[i]    = mux<bool, VCS>::mux_oh_case(sa1_grants[i], is_mcast[i]);
+        // A multicast flit keeps its VC, the rest move to their allocated VC
+        cr_t in_vc_sel   = 0;
+        #pragma hls_unroll yes
+        for (unsigned v=0; v<VCS; ++v) if (sa1_grants[i][v]) in_vc_sel = v;
+        if      (mc_to_xbar[i])   vc_to_xbar[i] = in_vc_sel;
+        else if (spec_to_xbar[i]) vc_to_xbar[i] = mux<cr_t, VCS>::mux_oh_case(sa1_grants[i], va1_vc);
+        else                      vc_to_xbar[i] = mux<cr_t, VCS>::mux_oh_case(sa1_grants[i], out_vc_locked[i]);
+        
+        // The packets that hold an output VC carry their QoS from their head. Otherwise the head requests speculatively
+        sc_uint<dnp::Q_W> vc_qos[VCS];
+        #pragma hls_unroll yes
+        for (unsigned v=0; v<VCS; ++v) vc_qos[v] = out_lock[i][v] ? qos_locked[i][v] : vc_hol_flit[i][v].get_qos();
+        qos_to_xbar[i] = mux<sc_uint<dnp::Q_W>, VCS>::mux_oh_case(sa1_grants[i], vc_qos);
+        
+        if (spec_to_xbar[i]) req_sa2_per_i[i] = mux<onehot<OUT_NUM>, VCS>::mux_oh_case(sa1_grants[i], va_port[i]).and_mask(any_sa1_gnt);
+        else                 req_sa2_per_i[i] = mux<onehot<OUT_NUM>, VCS>::mux_oh_case(sa1_grants[i], port_req_oh).and_mask(any_sa1_gnt);
       } // End of set inputs
   
       // Per Output arbitration and multiplexing
@@ -200,27 +370,70 @@ public:
         for(int i=0; i<IN_NUM; ++i) {
           req_sa2_per_o[j][i] = req_sa2_per_i[i][j];
         }
+        // VA2 : Each free output VC grants one of the input VCs that requested it
+        #pragma hls_unroll yes
+        for (unsigned w=0; w<VCS; ++w) {
+          sc_uint<IN_NUM*VCS> va2_req = 0;
+          #pragma hls_unroll yes
+          for (int i=0; i<IN_NUM; ++i) {
+            #pragma hls_unroll yes
+            for (unsigned v=0; v<VCS; ++v) va2_req[i*VCS+v] = va_req[i][v] && va_port[i][v][j] && va1_gnt[i][v][w];
+          }
+          va2_gnt[j][w] = 0;
+          arb_va2[j][w].arbitrate(va2_req, va2_gnt[j][w]);
+        }
+        
         // SA2 arbitration among the inputs to win the output and the required VC
-        bool any_gnt = arb_sa2[j].arbitrate(req_sa2_per_o[j].val, gnt_sa2_per_o[j].val);
+        //   Speculative requests compete only when no input requests non-speculatively
+        sc_uint<IN_NUM> req_sa2_spec = 0;
+        #pragma hls_unroll yes
+        for (int i=0; i<IN_NUM; ++i) req_sa2_spec[i] = req_sa2_per_o[j][i] && spec_to_xbar[i];
+        sc_uint<IN_NUM> req_sa2_nspec = req_sa2_per_o[j].val & (~req_sa2_spec);
+        sa2_arb_t arb_sa2_prev;
+        if (SPEC_SA) arb_sa2_prev = arb_sa2[j];
+        bool any_gnt = arb_sa2[j].arbitrate((req_sa2_nspec.or_reduce() ? req_sa2_nspec : req_sa2_spec), qos_to_xbar, gnt_sa2_per_o[j].val);
         
         flit_t selected_flit = mux<flit_t, IN_NUM>::mux_oh_case(gnt_sa2_per_o[j], flit_to_xbar);
-        cr_t   selected_vc   = selected_flit.get_vc();
+        cr_t   selected_vc   = mux<cr_t, IN_NUM>::mux_oh_case(gnt_sa2_per_o[j], vc_to_xbar);
+        bool   selected_mc   = mux<bool, IN_NUM>::mux_oh_case(gnt_sa2_per_o[j], mc_to_xbar);
+        bool   selected_spec = mux<bool, IN_NUM>::mux_oh_case(gnt_sa2_per_o[j], spec_to_xbar);
+        selected_flit.set_vc(selected_vc);
+        if (AGE && selected_flit.performs_rc()) selected_flit.set_qos(age_incr(selected_flit.get_qos()));
+        
+        // A speculative grant succeeds only if VA2 granted the same output VC to the same input VC
+        if (SPEC_SA && selected_spec) {
+          bool spec_ok = false;
+          #pragma hls_unroll yes
+          for (int i=0; i<IN_NUM; ++i) {
+            #pragma hls_unroll yes
+            for (unsigned v=0; v<VCS; ++v) {
+              #pragma hls_unroll yes
+              for (unsigned w=0; w<VCS; ++w) {
+                spec_ok = spec_ok || (gnt_sa2_per_o[j][i] && sa1_grants[i][v] && (selected_vc==w) && va2_gnt[j][w][i*VCS+v]);
+              }
+            }
+          }
+          // A failed grant leaves the SA1/SA2 priorities as they were, thus the input retries with its priority
+          if (!spec_ok) {
+            #pragma hls_unroll yes
+            for (int i=0; i<IN_NUM; ++i) spec_fail[i] = spec_fail[i] || gnt_sa2_per_o[j][i];
+            arb_sa2[j] = arb_sa2_prev;
+            any_gnt = false;
+            gnt_sa2_per_o[j] = onehot<IN_NUM>(0);
+          }
+        }
+        // Prune the multicast destinations to those behind this output
+        if (RC_METHOD==6) selected_flit.set_mcast(selected_flit.get_mcast() & lut_mcast_dst(j));
         
         data_val_out[j]  = any_gnt;
         data_data_out[j] = selected_flit;
         
-        #pragma hls_unroll yes
-        for (unsigned v=0; v<VCS; ++v) {
-          bool cr_upd_this_vc = cr_val_in[j] && (cr_data_in[j]==v);
-          bool cr_cons_this_vc = any_gnt     && (selected_vc  ==v);
-          if      ( cr_cons_this_vc && (!cr_upd_this_vc)) credits[j][v].decrease();
-          else if (!cr_cons_this_vc && ( cr_upd_this_vc)) credits[j][v].increase();
-        }
+        credits[j].update(any_gnt, selected_vc, cr_val_in[j], cr_data_in[j]);
+        
+        // The tail releases the output VC. Multicast flits never hold one, nor speculative SINGLE flits that
+        //   get and release it at the same cycle
+        if (any_gnt && !selected_mc && (selected_flit.is_tail() || (selected_flit.is_single() && !selected_spec))) out_available[j][selected_vc] = true;
         
-        if (any_gnt) {
-          if (selected_flit.is_head()) out_available[j][selected_vc] = false;
-          if (selected_flit.is_tail()) out_available[j][selected_vc] = true;
-        }
       } // End per output
       
       
@@ -228,34 +441,55 @@ public:
       #pragma hls_unroll yes
       inp_feedback : for (unsigned char i = 0; i < IN_NUM; ++i) {
         #pragma hls_unroll yes
-        for(int j=0; j<IN_NUM; ++j) {
+        for(int j=0; j<OUT_NUM; ++j) {
           gnt_sa2_per_i[i][j] = gnt_sa2_per_o[j][i];
         }
         
+        if (SPEC_SA && spec_fail[i]) arb_sa1[i] = arb_sa1_prev[i];
+        
         // Handle Grants and incoming flits
         bool sa2_grant = gnt_sa2_per_i[i].or_reduce();
-        cr_val_out[i]  = sa2_grant;
+        cr_val_out[i]  = false;
+        cr_data_out[i] = 0;
         bool got_new_flit = data_val_in[i];
         cr_t new_flit_vc  = data_data_in[i].get_vc();
         
-        if (got_new_flit) fifo[i][new_flit_vc].push_no_count_incr(data_data_in[i]);
-        
-        // Update the FIFO and VC state
-        cr_t vc_popped = 0;
+        // Update the VC state
         #pragma hls_unroll yes
         for (unsigned v=0; v<VCS; ++v) {
-          bool this_vc_popped = sa2_grant && sa1_grants[i][v];
+          bool this_vc_granted = sa2_grant && sa1_grants[i][v];
+          bool this_vc_popped  = this_vc_granted;
+          // A multicast flit leaves the VC after all its copies are sent
+          if (this_vc_granted && is_mcast[i][v]) {
+            sc_uint<OUT_NUM> mc_served = mc_sent[i][v] | gnt_sa2_per_i[i].val;
+            this_vc_popped = (mc_served == mc_ports[i][v]);
+            mc_sent[i][v]  = this_vc_popped ? (sc_uint<OUT_NUM>) 0 : mc_served;
+          }
           if (this_vc_popped) {
+            cr_val_out[i]  = true;
             cr_data_out[i] = v;
-            fifo[i][v].inc_pop_ptr();
             
-            if      (vc_hol_flit[i][v].is_head()) out_lock[i][v] = true;
-            else if (vc_hol_flit[i][v].is_tail()) out_lock[i][v] = false;
+            if (vc_hol_flit[i][v].is_tail() || vc_hol_flit[i][v].is_single()) out_lock[i][v] = false;
           }
           
-          bool this_vc_pushed = got_new_flit && (new_flit_vc==v);
-          fifo[i][v].set_count(this_vc_pushed, this_vc_popped);
+          // A VA2 grant locks the output and its VC for the packet. A SINGLE flit that departed speculatively is done
+          bool spec_done = this_vc_popped && vc_hol_flit[i][v].is_single();
+          #pragma hls_unroll yes
+          for (int j=0; j<OUT_NUM; ++j) {
+            #pragma hls_unroll yes
+            for (unsigned w=0; w<VCS; ++w) {
+              if (va2_gnt[j][w][i*VCS+v] && !spec_done) {
+                out_lock[i][v]         = true;
+                out_port_locked[i][v].set(j);
+                out_vc_locked[i][v]    = w;
+                qos_locked[i][v]       = vc_hol_flit[i][v].get_qos();
+                out_available[j][w]    = false;
+              }
+            }
+          }
         }
+        // The popped flit returns its credit
+        fifo[i].update(got_new_flit, new_flit_vc, data_data_in[i], cr_val_out[i], cr_data_out[i]);
       }
       
       // Write to outputs
@@ -279,6 +513,24 @@ public:
   
   
   
+  // Whether a packet on input VC in_vc may be allocated the VC out_vc of the output outp
+  //   With escape VC routing, the escape VC (i.e. VC == class) is restricted to the XY output
+  //   With torus routing, the VC must also belong to the dateline set of the hop
+  inline bool va_allowed (const unsigned in_vc, const unsigned out_vc, const unsigned char outp, sc_uint<dnp::D_W> destination, sc_uint<dnp::T_W> type, sc_uint<dnp::S_W> source) {
+    const unsigned VCS_PER_CLASS = VCS/VC_CLASSES;
+    unsigned cls = in_vc % VC_CLASSES;
+    if (outp >= EJ_PORT)        return (out_vc == cls);
+    else if (RC_METHOD==9)      return ((out_vc % VC_CLASSES) == cls) && ((out_vc != cls) || (outp == do_rc_xy_merge(destination, type)));
+    else if (RC_METHOD==10) {
+      const unsigned VCS_PER_SET = (VCS_PER_CLASS>1) ? VCS_PER_CLASS/2 : 1;
+      unsigned dl_set = dateline_set(source, outp);
+      if (VA_POLICY==VA_DST)    return (out_vc == cls + VC_CLASSES*(dl_set + 2*(destination.to_uint() % VCS_PER_SET)));
+      else                      return ((out_vc % VC_CLASSES) == cls) && (((out_vc/VC_CLASSES)%2) == dl_set);
+    }
+    else if (VA_POLICY==VA_DST) return (out_vc == cls + VC_CLASSES*(destination.to_uint() % VCS_PER_CLASS));
+    else                        return ((out_vc % VC_CLASSES) == cls);
+  };
+  
   // Direct RC : The Dst Node is the Output port
   //inline unsigned char do_rc_direct (const unsigned char destination) {return destination;};
   inline unsigned char do_rc_direct (sc_uint<dnp::D_W> destination) {return destination.to_uint();};
@@ -293,14 +545,137 @@ public:
     else if (type==dnp::PACK_TYPE__WR_REQ)  return destination.to_uint()+2;
     else                                    return destination.to_uint();
   };
+  // The age of a packet after one more hop, saturated
+  inline sc_uint<dnp::Q_W> age_incr (sc_uint<dnp::Q_W> age) {
+    return (age == ((1<<dnp::Q_W)-1)) ? age : (sc_uint<dnp::Q_W>)(age+1);
+  };
   inline unsigned char do_rc_lut (sc_uint<dnp::D_W> destination) {
     return route_lut[destination.to_uint()].read();
   };
   
+  // LUT Based multicast RC. Returns the outputs that lead to any of the destinations
+  inline sc_uint<OUT_NUM> do_rc_lut_mcast (sc_uint<dnp::MCAST_W> dst_mask) {
+    sc_uint<OUT_NUM> ports = 0;
+    #pragma hls_unroll yes
+    for (int n=0; n<NODES; ++n) {
+      if (dst_mask[n]) ports[route_lut[n].read()] = 1;
+    }
+    return ports;
+  };
+  // The destinations routed through an output
+  inline sc_uint<dnp::MCAST_W> lut_mcast_dst (unsigned char outp) {
+    sc_uint<dnp::MCAST_W> dst_mask = 0;
+    #pragma hls_unroll yes
+    for (int n=0; n<NODES; ++n) dst_mask[n] = (route_lut[n].read() == outp);
+    return dst_mask;
+  };
+  
   inline unsigned char do_rc_xy_merge  (sc_uint<dnp::D_W> destination, sc_uint<dnp::T_W> type) {
+    return xy_merge(destination, type, id_x.read(), id_y.read());
+  };
+  // Lookahead XY : The route at the neighbour behind outp, encoded as the port it leaves from, or as
+  //   the port it arrives from (i.e. the opposite side of outp) when it ejects there
+  inline sc_uint<2> do_la_xy_merge  (sc_uint<dnp::D_W> destination, sc_uint<dnp::T_W> type, unsigned char outp) {
+    sc_uint<dnp::D_W> next_id_x = id_x.read();
+    sc_uint<dnp::D_W> next_id_y = id_y.read();
+    if      (outp==0) next_id_x--;
+    else if (outp==1) next_id_x++;
+    else if (outp==2) next_id_y--;
+    else              next_id_y++;
+    
+    unsigned char next_op = xy_merge(destination, type, next_id_x, next_id_y);
+    return (next_op<4) ? next_op : (outp^1);
+  };
+  // Lookahead RC : Decodes the route computed by the previous router
+  inline unsigned char do_rc_la  (sc_uint<2> la, sc_uint<dnp::T_W> type, unsigned char inp) {
+    if (la!=inp) return la.to_uint();
+    else         return (type==dnp::PACK_TYPE__RD_REQ || type==dnp::PACK_TYPE__RD_RESP) ? 4 : 5;
+  };
+  // Adaptive merged RD/WR : Among the minimal directions that the turn model permits, prefers one that is free,
+  //   thus it has a free VC with credits. Ties are resolved X first, as XY.
+  inline unsigned char do_rc_adaptive  (sc_uint<dnp::D_W> destination, sc_uint<dnp::S_W> source, sc_uint<dnp::T_W> type, sc_uint<4> free_dirs) {
+    sc_uint<4> dirs = adaptive_dirs(destination, source);
+    if (dirs==0) return (type==dnp::PACK_TYPE__RD_REQ || type==dnp::PACK_TYPE__RD_RESP) ? 4 : 5;
+    
+    sc_uint<4> dirs_free = dirs & free_dirs;
+    if (dirs_free!=0) dirs = dirs_free;
+    
+    if      (dirs[0]) return 0;
+    else if (dirs[1]) return 1;
+    else if (dirs[2]) return 2;
+    else              return 3;
+  };
+  // The minimal directions W(0), E(1), N(2), S(3) that the turn model permits
+  //   West-First : Westward hops are taken first and deterministically, then any of E/N/S.
+  //   Odd-Even   : No East to North/South turns at even columns, and no North/South to West turns at odd columns.
+  //                The source column is exempt, as the packet has not travelled East yet.
+  //   Escape VC  : Every minimal direction. Deadlock freedom comes from the XY escape VC instead.
+  inline sc_uint<4> adaptive_dirs  (sc_uint<dnp::D_W> destination, sc_uint<dnp::S_W> source) {
     sc_uint<dnp::D_W> this_id_x = id_x.read();
     sc_uint<dnp::D_W> this_id_y = id_y.read();
     
+    sc_uint<dnp::D_W> dst_x = destination % DIM_X;
+    sc_uint<dnp::D_W> dst_y = destination / DIM_X;
+    sc_uint<dnp::D_W> src_x = source % DIM_X;
+    
+    bool          go_y = (dst_y!=this_id_y);
+    unsigned char vert = (dst_y>this_id_y) ? 3 : 2;
+    
+    sc_uint<4> dirs = 0;
+    if (RC_METHOD==9) {
+      if      (dst_x<this_id_x) dirs[0] = 1;
+      else if (dst_x>this_id_x) dirs[1] = 1;
+      if (go_y)                 dirs[vert] = 1;
+    } else if (RC_METHOD==7) {
+      if (dst_x<this_id_x) {
+        dirs[0] = 1;
+      } else {
+        if (dst_x>this_id_x) dirs[1] = 1;
+        if (go_y)            dirs[vert] = 1;
+      }
+    } else {
+      if (dst_x==this_id_x) {
+        if (go_y) dirs[vert] = 1;
+      } else if (dst_x>this_id_x) {
+        if (!go_y) {
+          dirs[1] = 1;
+        } else {
+          if (this_id_x[0] || (this_id_x==src_x))  dirs[vert] = 1;
+          if (dst_x[0] || ((dst_x-this_id_x)!=1)) dirs[1] = 1;
+        }
+      } else {
+        dirs[0] = 1;
+        if (!this_id_x[0] && go_y) dirs[vert] = 1;
+      }
+    }
+    return dirs;
+  };
+  // Torus XY : Dimension order routing, taking the shorter direction of each ring
+  inline unsigned char do_rc_torus  (sc_uint<dnp::D_W> destination, sc_uint<dnp::T_W> type) {
+    unsigned this_id_x = id_x.read().to_uint();
+    unsigned this_id_y = id_y.read().to_uint();
+    
+    unsigned dist_x = (destination.to_uint() % DIM_X + DIM_X - this_id_x) % DIM_X; // Hops towards East
+    unsigned dist_y = (destination.to_uint() / DIM_X + DIM_Y - this_id_y) % DIM_Y; // Hops towards South
+    
+    if      (dist_x!=0) return (dist_x <= DIM_X/2) ? 1 : 0;
+    else if (dist_y!=0) return (dist_y <= DIM_Y/2) ? 3 : 2;
+    else                return (type==dnp::PACK_TYPE__RD_REQ || type==dnp::PACK_TYPE__RD_RESP) ? 4 : 5;
+  };
+  // Dateline : The VC set of the hop towards outp. Set 1 from the wrap-around link of the ring, that is
+  //   detected by the position of the router relative to the source of the packet
+  inline unsigned dateline_set  (sc_uint<dnp::S_W> source, unsigned char outp) {
+    unsigned this_id_x = id_x.read().to_uint();
+    unsigned this_id_y = id_y.read().to_uint();
+    unsigned src_x     = source.to_uint() % DIM_X;
+    unsigned src_y     = source.to_uint() / DIM_X; // The row where the packet turns to Y
+    
+    if      (outp==0) return ((this_id_x==0)       || (this_id_x>src_x)) ? 1 : 0;
+    else if (outp==1) return ((this_id_x==DIM_X-1) || (this_id_x<src_x)) ? 1 : 0;
+    else if (outp==2) return ((this_id_y==0)       || (this_id_y>src_y)) ? 1 : 0;
+    else              return ((this_id_y==DIM_Y-1) || (this_id_y<src_y)) ? 1 : 0;
+  };
+  inline unsigned char xy_merge  (sc_uint<dnp::D_W> destination, sc_uint<dnp::T_W> type, sc_uint<dnp::D_W> this_id_x, sc_uint<dnp::D_W> this_id_y) {
     sc_uint<dnp::D_W> dst_x = destination % DIM_X;
     sc_uint<dnp::D_W> dst_y = destination / DIM_X;
     
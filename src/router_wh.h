@@ -20,14 +20,37 @@
 //               - 3 : For single stage NoCs
 //               - 4 : LUT based RC
 //               - 5 : XY routing with merged RD/WR Req-Resp
+//               - 6 : LUT based RC with multicast. A SINGLE flit with a destination mask forks
+//                     to every output that leads to a destination, in the same or later cycles.
+//                     Each copy carries only the destinations behind its output.
+//               - 7 : Adaptive minimal routing with the West-First turn model, merged RD/WR Req-Resp
+//               - 8 : Adaptive minimal routing with the Odd-Even turn model, merged RD/WR Req-Resp
+//                     Both select among the permitted minimal outputs one that is free. Packets to the same
+//                     destination may be reordered, thus the masters must use ORD_SCHEME 2.
+//               - 11: Source routing. The head flit carries the output port of every hop, written by the
+//                     network interface (see src_route.h). The router pops its entry, thus it needs no routing logic.
 // DIM_X     : X Dimension of a 2-D mesh network. Used in XY routing
 // NODES     : All possible target nodes of the network. Used in LUT routing
-// ARB_C     : The arbiter type. Eg MATRIX, ROUND_ROBIN
-template<unsigned int IN_NUM, unsigned int OUT_NUM, class flit_t, int RC_METHOD=0, int DIM_X=0, int NODES=1, class ARB_C=arbiter<IN_NUM, MATRIX> >
+// ARB_C     : The arbiter type. Eg MATRIX, ROUND_ROBIN, PREFIX_RR, or the two-level HIER_MATRIX, HIER_RR for more than 8 inputs
+// LA_RC     : Lookahead RC, for XY routing (RC_METHOD 5). The head flit carries its output port at this router,
+//             computed by the previous one, thus it requests the switch without waiting for RC.
+//             In parallel, the router computes the output port at the next router and writes it in the head.
+//             The port is encoded in 2 bits as W/E/N/S, where the port the flit arrives from means ejection,
+//             since XY routing never turns back. Flits from the local inputs (4, 5) are routed as usual.
+// QOS       : QoS arbitration. The packets of the highest QoS level (the Q field of the head) win the output,
+//             and ARB_C arbitrates among them. Inputs that keep losing are eventually served (see qos_arbiter).
+// AGE       : Age based arbitration. The Q field of the head counts the hops of the packet, incremented at
+//             every router up to its maximum, and the oldest packets win the output as with QOS. Thus the
+//             packets of distant nodes are not penalized at every hop. Exclusive with QOS.
+// WGT       : Runtime weights of a weighted ARB_C (WEIGHTED_RR, DEFICIT_RR). The arb_weight inputs set the
+//             weight of each input at every output, thus the inputs share the outputs' bandwidth by them.
+template<unsigned int IN_NUM, unsigned int OUT_NUM, class flit_t, int RC_METHOD=0, int DIM_X=0, int NODES=1, class ARB_C=arbiter<IN_NUM, MATRIX>, bool LA_RC=false, bool QOS=false, bool AGE=false, bool WGT=false >
 SC_MODULE(router_wh_top) {
   
   typedef sc_uint< clog2<OUT_NUM>::val > port_w_t;
   
+  static_assert(!LA_RC || flit_t::HAS_LA, "Lookahead RC requires a flit type that carries the lookahead route.");
+  
   sc_in_clk    clk{"clk"};
 	sc_in <bool> rst_n{"rst_n"};
   
@@ -37,6 +60,9 @@ SC_MODULE(router_wh_top) {
   // id_x and id_y are the X,Y dimensions of the router in a 2-D mesh network. Otherwise Not-Used 
   sc_in< sc_uint<dnp::D_W> >  id_x{"id_x"};
 	sc_in< sc_uint<dnp::D_W> >  id_y{"id_y"};
+  
+  // The arbitration weight of each input, only with WGT
+  typename opt_in< WGT, sc_uint<8> >::type  arb_weight[IN_NUM];
 	
   // Input channels
   Connections::InBuffered <flit_t, 2>  data_in[IN_NUM];
@@ -48,17 +74,23 @@ SC_MODULE(router_wh_top) {
   bool out_lock[IN_NUM];
   // Each input stores its required outport (for body/tail flits)
   port_w_t out_port[IN_NUM];
+  // Each input stores the outputs that already got a copy of its multicast flit
+  sc_uint<OUT_NUM> mc_sent[IN_NUM];
   
   // Per Output 
   // out available holds the availability of the corresponding output port
   bool   out_available[OUT_NUM];
-  ARB_C  arbiter[OUT_NUM];
+  qos_arbiter<IN_NUM, ARB_C, (QOS || AGE), dnp::Q_W>  arbiter[OUT_NUM];
   
   // Constructor
   SC_HAS_PROCESS(router_wh_top);
   router_wh_top(sc_module_name name_="router_wh_top")
     : sc_module(name_)
   { 
+    NVHLS_ASSERT_MSG(!LA_RC || RC_METHOD==5, "Lookahead RC requires XY routing.");
+    NVHLS_ASSERT_MSG(!(QOS && AGE), "QoS and age based arbitration share the Q field.");
+    NVHLS_ASSERT_MSG((RC_METHOD!=11) || (OUT_NUM<=(1<<dnp::SR_W)), "The outputs exceed the source route entry.");
+    NVHLS_ASSERT_MSG((RC_METHOD!=6) || (NODES<=dnp::MCAST_W), "The nodes exceed the multicast mask.");
     SC_THREAD(router_job);
     sensitive << clk.pos();
     async_reset_signal_is(rst_n, false);
@@ -70,6 +102,7 @@ SC_MODULE(router_wh_top) {
       data_in[i].Reset();
       out_lock[i]       = false;
       out_port[i]       = 0;
+      mc_sent[i]        = 0;
     }
   #pragma hls_unroll yes
   per_o_rst:for(unsigned char o=0; o<OUT_NUM; ++o) {
@@ -84,6 +117,8 @@ SC_MODULE(router_wh_top) {
       wait();
       bool   fifo_valid[IN_NUM];
       flit_t hol_data[IN_NUM];
+      // The QoS of the heads. The rest of the flits request a locked output, thus have no competitors
+      sc_uint<dnp::Q_W> qos_per_i[IN_NUM];
       
       // The request and grants of the Inputs/Outputs
       bool qualified_reqs[OUT_NUM][IN_NUM];
@@ -95,6 +130,10 @@ SC_MODULE(router_wh_top) {
       
       bool is_inp_granted[IN_NUM][OUT_NUM];
       
+      // Multicast flits and their required outputs
+      bool             is_mcast[IN_NUM];
+      sc_uint<OUT_NUM> mc_ports[IN_NUM];
+      
       // Input logic, loops for each input to produce the required requests
       #pragma hls_unroll yes
       set_inp: for (int ip=0; ip<IN_NUM; ++ip) {
@@ -107,6 +146,10 @@ SC_MODULE(router_wh_top) {
           hol_data[ip] = data_in[ip].Peek();
         }
     
+        bool ready_outp[OUT_NUM];
+        #pragma hls_unroll yes
+        for (int op=0; op<OUT_NUM; ++op) ready_outp[op] = !data_out[op].Full();
+        
         // Depending the Flit type the input selects an output port to request.
         // The required output gets stored to be used by the rest of the flits.
         port_w_t  current_op;
@@ -118,25 +161,52 @@ SC_MODULE(router_wh_top) {
           else if (RC_METHOD==2) { current_op = do_rc_type(hol_data[ip].get_type());} // Return 0/1 depending the type. used for splitters
           else if (RC_METHOD==3) { current_op = do_rc_common(hol_data[ip].get_dst(), hol_data[ip].get_type());}
           else if (RC_METHOD==4) { current_op = do_rc_lut(hol_data[ip].get_dst());}
-          else if (RC_METHOD==5) { current_op = do_rc_xy_merge(hol_data[ip].get_dst(), hol_data[ip].get_type());}
+          else if (RC_METHOD==5) {
+            if (LA_RC && ip<4) current_op = do_rc_la(hol_data[ip].get_la(), hol_data[ip].get_type(), ip); // Precomputed upstream
+            else               current_op = do_rc_xy_merge(hol_data[ip].get_dst(), hol_data[ip].get_type());
+          }
+          else if (RC_METHOD==6) { current_op = do_rc_lut(hol_data[ip].get_dst());} // Unicast, else the multicast outputs are used
+          else if (RC_METHOD==7 || RC_METHOD==8) {
+            // A waiting head re-routes every cycle, towards the mesh outputs that are free
+            sc_uint<4> free_dirs = 0;
+            #pragma hls_unroll yes
+            for (int op=0; op<OUT_NUM; ++op) if (op<4) free_dirs[op] = ready_outp[op] && out_available[op];
+            current_op = do_rc_adaptive(hol_data[ip].get_dst(), hol_data[ip].get_src(), hol_data[ip].get_type(), free_dirs);
+          }
+          else if (RC_METHOD==11) { current_op = hol_data[ip].get_sr();} // Precomputed at the source
           else                   { NVHLS_ASSERT_MSG(0, "Wrong Routing method selected.");}
           
+          // The next router finds its entry at the LSBs. Cleared after ejecting
+          if (RC_METHOD==11) hol_data[ip].pop_sr();
+          // The route of the next router, in parallel to switch allocation. Cleared when ejecting
+          if (LA_RC) hol_data[ip].set_la((current_op<4) ? do_la_xy_merge(hol_data[ip].get_dst(), hol_data[ip].get_type(), current_op) : (sc_uint<2>) 0);
+          
           out_port[ip] = current_op;
         } else {
           current_op = out_port[ip];
         }
+        qos_per_i[ip] = is_head_single ? hol_data[ip].get_qos() : (sc_uint<dnp::Q_W>) 0;
         
         // The required output port must be also Ready and or available.
-        sc_uint<OUT_NUM> port_req_oh = (1<<current_op); //;wb2oh_case<OUT_NUM>(current_op);// (1<<current_op);
-        bool ready_outp[OUT_NUM];
-        #pragma hls_unroll yes
-        for (int op=0; op<OUT_NUM; ++op) ready_outp[op] = !data_out[op].Full();
-  
-        bool outp_ready = mux<bool, OUT_NUM>::mux_oh_case(port_req_oh, ready_outp);
-        bool outp_avail = mux<bool, OUT_NUM>::mux_oh_case(port_req_oh, out_available);
+        sc_uint<OUT_NUM> port_req_oh = ((sc_uint<OUT_NUM>) 1) << current_op;
+        
+        // A multicast flit requests every output that has not yet received its copy
+        is_mcast[ip] = (RC_METHOD==6) && fifo_valid[ip] && (hol_data[ip].get_mcast() != 0);
+        mc_ports[ip] = is_mcast[ip] ? do_rc_lut_mcast(hol_data[ip].get_mcast()) : (sc_uint<OUT_NUM>) 0;
+        NVHLS_ASSERT_MSG(!is_mcast[ip] || hol_data[ip].is_single(), "Only SINGLE flits can be multicast.");
         
-        bool all_ok = (fifo_valid[ip] && outp_ready && (out_lock[ip] || (is_head_single && outp_avail)));
-        req_per_i[ip] = all_ok ? port_req_oh : (sc_uint<OUT_NUM>) 0;
+        if (is_mcast[ip]) {
+          sc_uint<OUT_NUM> mc_req = 0;
+          #pragma hls_unroll yes
+          for (int op=0; op<OUT_NUM; ++op) mc_req[op] = mc_ports[ip][op] && !mc_sent[ip][op] && ready_outp[op] && out_available[op];
+          req_per_i[ip] = mc_req;
+        } else {
+          bool outp_ready = mux<bool, OUT_NUM>::mux_oh_case(port_req_oh, ready_outp);
+          bool outp_avail = mux<bool, OUT_NUM>::mux_oh_case(port_req_oh, out_available);
+          
+          bool all_ok = (fifo_valid[ip] && outp_ready && (out_lock[ip] || (is_head_single && outp_avail)));
+          req_per_i[ip] = all_ok ? port_req_oh : (sc_uint<OUT_NUM>) 0;
+        }
       } // End of set_inp
       
       swap_dim< sc_uint<OUT_NUM>, IN_NUM, sc_uint<IN_NUM>, OUT_NUM >( req_per_i, req_per_o );
@@ -147,10 +217,15 @@ SC_MODULE(router_wh_top) {
         bool      any_gnt; // the output has been granted
         port_w_t  gnt_ip;  // Input port that got grant
   
-        any_gnt = arbiter[op].arbitrate(req_per_o[op], gnt_per_o[op]);
+        #pragma hls_unroll yes
+        for (int ip=0; ip<IN_NUM; ++ip) arb_weights<WGT>::set(arbiter[op], ip, arb_weight[ip].read());
+        any_gnt = arbiter[op].arbitrate(req_per_o[op], qos_per_i, gnt_per_o[op]);
         
         flit_t selected_flit;
         selected_flit = mux<flit_t, IN_NUM>::mux_oh_case(gnt_per_o[op], hol_data);
+        // Prune the multicast destinations to those behind this output
+        if (RC_METHOD==6) selected_flit.set_mcast(selected_flit.get_mcast() & lut_mcast_dst(op));
+        if (AGE && selected_flit.performs_rc()) selected_flit.set_qos(age_incr(selected_flit.get_qos()));
         if(any_gnt) {
           data_out[op].Push(selected_flit);
           
@@ -164,7 +239,16 @@ SC_MODULE(router_wh_top) {
       // Loop through each input to handle the case of actually winning the output
       #pragma hls_unroll yes
       popped_i:for (unsigned char ip=0; ip<IN_NUM; ++ip){
-        if (gnt_per_i[ip].or_reduce()) {
+        if (is_mcast[ip]) {
+          // A multicast flit leaves the input after all its copies are sent
+          sc_uint<OUT_NUM> mc_served = mc_sent[ip] | gnt_per_i[ip];
+          if (mc_served == mc_ports[ip]) {
+            mc_sent[ip] = 0;
+            data_in[ip].Pop();
+          } else {
+            mc_sent[ip] = mc_served;
+          }
+        } else if (gnt_per_i[ip].or_reduce()) {
           // Update the local lock bit depending the flit type
           //   Head->locks Tail->unlocks
           if     (hol_data[ip].is_head()) out_lock[ip] = true;
@@ -203,15 +287,107 @@ SC_MODULE(router_wh_top) {
     else if (type==dnp::PACK_TYPE__WR_REQ)  return destination.to_uint()+2;
     else                                    return destination.to_uint();
   };
+  // The age of a packet after one more hop, saturated
+  inline sc_uint<dnp::Q_W> age_incr (sc_uint<dnp::Q_W> age) {
+    return (age == ((1<<dnp::Q_W)-1)) ? age : (sc_uint<dnp::Q_W>)(age+1);
+  };
   // LUT Based RC
   inline unsigned char do_rc_lut (sc_lv<dnp::D_W> destination) {
     return route_lut[destination.to_uint()].read();
   };
+  // LUT Based multicast RC. Returns the outputs that lead to any of the destinations
+  inline sc_uint<OUT_NUM> do_rc_lut_mcast (sc_uint<dnp::MCAST_W> dst_mask) {
+    sc_uint<OUT_NUM> ports = 0;
+    #pragma hls_unroll yes
+    for (int n=0; n<NODES; ++n) {
+      if (dst_mask[n]) ports[route_lut[n].read()] = 1;
+    }
+    return ports;
+  };
+  // The destinations routed through an output
+  inline sc_uint<dnp::MCAST_W> lut_mcast_dst (unsigned char outp) {
+    sc_uint<dnp::MCAST_W> dst_mask = 0;
+    #pragma hls_unroll yes
+    for (int n=0; n<NODES; ++n) dst_mask[n] = (route_lut[n].read() == outp);
+    return dst_mask;
+  };
   // XY merged RD/WR
   inline unsigned char do_rc_xy_merge  (sc_uint<dnp::D_W> destination, sc_uint<dnp::T_W> type) {
+    return xy_merge(destination, type, id_x.read(), id_y.read());
+  };
+  // Lookahead XY : The route at the neighbour behind outp, encoded as the port it leaves from, or as
+  //   the port it arrives from (i.e. the opposite side of outp) when it ejects there
+  inline sc_uint<2> do_la_xy_merge  (sc_uint<dnp::D_W> destination, sc_uint<dnp::T_W> type, unsigned char outp) {
+    sc_uint<dnp::D_W> next_id_x = id_x.read();
+    sc_uint<dnp::D_W> next_id_y = id_y.read();
+    if      (outp==0) next_id_x--;
+    else if (outp==1) next_id_x++;
+    else if (outp==2) next_id_y--;
+    else              next_id_y++;
+    
+    unsigned char next_op = xy_merge(destination, type, next_id_x, next_id_y);
+    return (next_op<4) ? next_op : (outp^1);
+  };
+  // Lookahead RC : Decodes the route computed by the previous router
+  inline unsigned char do_rc_la  (sc_uint<2> la, sc_uint<dnp::T_W> type, unsigned char inp) {
+    if (la!=inp) return la.to_uint();
+    else         return (type==dnp::PACK_TYPE__RD_REQ || type==dnp::PACK_TYPE__RD_RESP) ? 4 : 5;
+  };
+  // Adaptive merged RD/WR : Among the minimal directions that the turn model permits, prefers one that is free,
+  //   thus not Full and not held by another packet. Ties are resolved X first, as XY.
+  inline unsigned char do_rc_adaptive  (sc_uint<dnp::D_W> destination, sc_uint<dnp::S_W> source, sc_uint<dnp::T_W> type, sc_uint<4> free_dirs) {
+    sc_uint<4> dirs = adaptive_dirs(destination, source);
+    if (dirs==0) return (type==dnp::PACK_TYPE__RD_REQ || type==dnp::PACK_TYPE__RD_RESP) ? 4 : 5;
+    
+    sc_uint<4> dirs_free = dirs & free_dirs;
+    if (dirs_free!=0) dirs = dirs_free;
+    
+    if      (dirs[0]) return 0;
+    else if (dirs[1]) return 1;
+    else if (dirs[2]) return 2;
+    else              return 3;
+  };
+  // The minimal directions W(0), E(1), N(2), S(3) that the turn model permits
+  //   West-First : Westward hops are taken first and deterministically, then any of E/N/S.
+  //   Odd-Even   : No East to North/South turns at even columns, and no North/South to West turns at odd columns.
+  //                The source column is exempt, as the packet has not travelled East yet.
+  inline sc_uint<4> adaptive_dirs  (sc_uint<dnp::D_W> destination, sc_uint<dnp::S_W> source) {
     sc_uint<dnp::D_W> this_id_x = id_x.read();
     sc_uint<dnp::D_W> this_id_y = id_y.read();
-  
+    
+    sc_uint<dnp::D_W> dst_x = destination % DIM_X;
+    sc_uint<dnp::D_W> dst_y = destination / DIM_X;
+    sc_uint<dnp::D_W> src_x = source % DIM_X;
+    
+    bool          go_y = (dst_y!=this_id_y);
+    unsigned char vert = (dst_y>this_id_y) ? 3 : 2;
+    
+    sc_uint<4> dirs = 0;
+    if (RC_METHOD==7) {
+      if (dst_x<this_id_x) {
+        dirs[0] = 1;
+      } else {
+        if (dst_x>this_id_x) dirs[1] = 1;
+        if (go_y)            dirs[vert] = 1;
+      }
+    } else {
+      if (dst_x==this_id_x) {
+        if (go_y) dirs[vert] = 1;
+      } else if (dst_x>this_id_x) {
+        if (!go_y) {
+          dirs[1] = 1;
+        } else {
+          if (this_id_x[0] || (this_id_x==src_x))  dirs[vert] = 1;
+          if (dst_x[0] || ((dst_x-this_id_x)!=1)) dirs[1] = 1;
+        }
+      } else {
+        dirs[0] = 1;
+        if (!this_id_x[0] && go_y) dirs[vert] = 1;
+      }
+    }
+    return dirs;
+  };
+  inline unsigned char xy_merge  (sc_uint<dnp::D_W> destination, sc_uint<dnp::T_W> type, sc_uint<dnp::D_W> this_id_x, sc_uint<dnp::D_W> this_id_y) {
     sc_uint<dnp::D_W> dst_x = destination % DIM_X;
     sc_uint<dnp::D_W> dst_y = destination / DIM_X;
     
@@ -0,0 +1,120 @@
+#ifndef __RT_TABLE_H__
+#define __RT_TABLE_H__
+
+#include "systemc.h"
+#include "nvhls_connections.h"
+
+#include "./include/flit_axi.h"
+
+#ifndef __SYNTHESIS__
+  #include <iostream>
+#endif
+
+// A routing table update. Sets the output port towards dst, at the table rt_id or at every table (all)
+struct rt_cfg_t {
+  static const unsigned ID_W = 8; // Up to 256 tables in a configuration chain
+
+  sc_uint<ID_W>       rt_id;
+  bool                all;
+  sc_uint<dnp::D_W>   dst;
+  sc_uint<dnp::D_W>   port;
+
+  static const int width = ID_W+1+dnp::D_W+dnp::D_W; // Matchlib Marshaller requirement
+
+  rt_cfg_t () : rt_id(0), all(false), dst(0), port(0) {};
+
+  inline friend std::ostream& operator << ( std::ostream& os, const rt_cfg_t& upd ) {
+    if (upd.all) os << "RT*";
+    else         os << "RT" << upd.rt_id;
+    os << " d" << upd.dst << "->p" << upd.port;
+    #ifdef SYSTEMC_INCLUDED
+    os << "@" << sc_time_stamp();
+    #endif
+    return os;
+  }
+
+#ifdef SYSTEMC_INCLUDED
+  inline friend void sc_trace(sc_trace_file* tf, const rt_cfg_t& upd, const std::string& name) {
+    sc_trace(tf, upd.rt_id, name + ".rt_id");
+    sc_trace(tf, upd.all,   name + ".all");
+    sc_trace(tf, upd.dst,   name + ".dst");
+    sc_trace(tf, upd.port,  name + ".port");
+  }
+#endif
+
+  // Matchlib Marshaller requirement
+  template<unsigned int Size>
+  void Marshall(Marshaller<Size>& m) {
+    m& rt_id;
+    m& all;
+    m& dst;
+    m& port;
+  };
+};
+
+// Runtime programmable routing table of a router with LUT based routing (RC_METHOD 4/6).
+//   The table drives the route_lut inputs of its router, thus routes change without regenerating the RTL,
+//   e.g. to steer traffic away from hot links. The tables of a network form a chain on their configuration
+//   channel. Each table applies the updates addressed to it (RT_ID) or to all tables, and forwards every
+//   update to the next one. The chain ends back at the configuration agent, thus a returned update has
+//   reached every table. An update affects the packets routed after it, while the packets in flight keep
+//   their route. The agent must keep the routes deadlock free, and the ordering of the AXI interfaces may
+//   require draining the affected destinations before rerouting them.
+// NODES : The destinations of the table, as the NODES of the router
+template <unsigned NODES>
+SC_MODULE(rt_table) {
+  sc_in_clk    clk;
+  sc_in <bool> rst_n;
+
+  sc_in< sc_uint<rt_cfg_t::ID_W> >  RT_ID;
+
+  Connections::In<rt_cfg_t>   cfg_in;
+  Connections::Out<rt_cfg_t>  cfg_out; // Towards the next table of the chain
+
+  sc_out< sc_uint<dnp::D_W> >  route_lut[NODES];
+
+  // Internals
+  sc_uint<dnp::D_W>  table[NODES];
+
+  SC_HAS_PROCESS(rt_table);
+  rt_table(sc_module_name name_="rt_table") : sc_module(name_)
+  {
+    SC_THREAD(table_job);
+    sensitive << clk.pos();
+    async_reset_signal_is(rst_n, false);
+  }
+
+  void table_job() {
+    rt_cfg_t fwd_upd;
+    bool     fwd_val = false;
+
+    cfg_in.Reset();
+    cfg_out.Reset();
+    #pragma hls_unroll yes
+    for (unsigned n=0; n<NODES; ++n) {
+      table[n] = 0;
+      route_lut[n].write(0);
+    }
+
+    #pragma hls_pipeline_init_interval 1
+    #pragma pipeline_stall_mode flush
+    while(1) {
+      wait();
+
+      // A new update is accepted once the previous one is forwarded
+      if (!fwd_val) {
+        fwd_val = cfg_in.PopNB(fwd_upd);
+        if (fwd_val && (fwd_upd.all || (fwd_upd.rt_id == RT_ID.read()))) {
+          NVHLS_ASSERT_MSG(fwd_upd.dst.to_uint() < NODES, "Routing table update out of range.");
+          if (fwd_upd.dst.to_uint() < NODES) table[fwd_upd.dst.to_uint()] = fwd_upd.port;
+        }
+      }
+      if (fwd_val) fwd_val = !cfg_out.PushNB(fwd_upd);
+
+      #pragma hls_unroll yes
+      for (unsigned n=0; n<NODES; ++n) route_lut[n].write(table[n]);
+    }
+  };
+}; // End of rt_table
+
+#endif // __RT_TABLE_H__
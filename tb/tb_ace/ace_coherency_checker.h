@@ -4,6 +4,7 @@
 #include "systemc.h"
 
 #include "../../src/include/dnp_ace_v0.h"
+#include "../../src/ace/ace_home.h"
 
 #include <deque>
 #include <queue>
@@ -58,10 +59,12 @@ SC_MODULE(ace_coherency_checker) {
     ace5_::CD cd[FULL_MASTER_NUM];
     bool      valid[FULL_MASTER_NUM];
     unsigned  count; // Must never
+    unsigned  initiator; // As the HOME reported it, when the first Snoop arrived
     
     snoop_trans_bundle () {
       for(int i=0; i<FULL_MASTER_NUM; ++i) valid[i] = false;
-      count = 0;
+      count     = 0;
+      initiator = 0;
     };
     
     snoop_trans_bundle (
@@ -122,6 +125,14 @@ SC_MODULE(ace_coherency_checker) {
   
   std::map<ace5_::Addr, snoop_trans_bundle> scrutineer; // Wow, nice word. Not gonna remember it. Don't care. Still Gonna use. Long live autocomplete!
   
+#ifdef TB_MEM_SIDE_CACHE
+  // Memory image of the coherent lines, a byte per address. A memory side cache holds the coherent Writes and
+  //   the write-backs, thus the Reads it serves get their data from here. Bytes never written keep the Slave pattern
+  std::map<ace5_::Addr, unsigned char> mem_img;
+  
+  void mem_img_write (ace5_::Addr addr, ace5_::Data data, unsigned bytes);
+#endif
+  
   // Read Response Generator
   int rd_resp_val;
   int rd_resp_generated;
@@ -189,17 +200,6 @@ void ace_coherency_checker<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, FULL_
           (*sb_snoop_data_resp_q)[i].pop_front();
         }
   
-        // resolve who is the initiator, to know the number of the expected snoop reqs
-        // ID format -> 0 - SLAVES - FULL_MASTERS - LITE_MASTERS - HOMES
-        unsigned initiator = snoop_req.prot;
-        NVHLS_ASSERT_MSG(initiator>=SLAVE_NUM, "A SLAVE cannot be an initiator. (I.e. ID<SLAVE_NUM)")
-        NVHLS_ASSERT_MSG(initiator<(SLAVE_NUM+FULL_MASTER_NUM+LITE_MASTER_NUM), "A HOME cannot be an initiator. (I.e. ID greater than the masters')")
-        unsigned init_is_ace  = (initiator<(SLAVE_NUM+FULL_MASTER_NUM));
-        unsigned init_is_lite = (initiator>=(SLAVE_NUM+FULL_MASTER_NUM));
-        NVHLS_ASSERT_MSG(initiator<(SLAVE_NUM+FULL_MASTER_NUM+LITE_MASTER_NUM), "Wot?!?! Check the 2lines above....")
-        
-        
-        
         auto cur_trans_bundle_it = scrutineer.find(snoop_req.addr);
         //if tha address is not init in scrutineer, create it.
         if ( cur_trans_bundle_it == scrutineer.end() ) { // Not found
@@ -208,6 +208,21 @@ void ace_coherency_checker<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, FULL_
           cur_trans_bundle_it = scrutineer.find(snoop_req.addr);
         }
         
+        // resolve who is the initiator, to know the number of the expected snoop reqs
+        //   The HOMEs report the initiators of their Snoops per line, in order. Thus a new bundle takes the oldest
+        if ((cur_trans_bundle_it->second).count == 0) {
+          std::deque<unsigned> &line_inits = ace_home_snoop_inits()[snoop_req.addr.to_uint64()];
+          NVHLS_ASSERT_MSG(!line_inits.empty(), "A Snoop arrived that no HOME sent.")
+          (cur_trans_bundle_it->second).initiator = line_inits.front();
+          line_inits.pop_front();
+        }
+        // ID format -> 0 - SLAVES - FULL_MASTERS - LITE_MASTERS - HOMES
+        unsigned initiator = (cur_trans_bundle_it->second).initiator;
+        NVHLS_ASSERT_MSG(initiator>=SLAVE_NUM, "A SLAVE cannot be an initiator. (I.e. ID<SLAVE_NUM)")
+        NVHLS_ASSERT_MSG(initiator<(SLAVE_NUM+FULL_MASTER_NUM+LITE_MASTER_NUM), "A HOME cannot be an initiator. (I.e. ID greater than the masters')")
+        unsigned init_is_ace  = (initiator<(SLAVE_NUM+FULL_MASTER_NUM));
+        unsigned init_is_lite = (initiator>=(SLAVE_NUM+FULL_MASTER_NUM));
+        NVHLS_ASSERT_MSG(initiator<(SLAVE_NUM+FULL_MASTER_NUM+LITE_MASTER_NUM), "Wot?!?! Check the 2lines above....")
         
         unsigned new_count = (cur_trans_bundle_it->second).push(i, snoop_req, snoop_resp, snoop_data);
         // Existing Address of scrutineer
@@ -240,7 +255,7 @@ template <unsigned int RD_M_LANES, unsigned int RD_S_LANES, unsigned int WR_M_LA
 void ace_coherency_checker<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, FULL_MASTER_NUM, LITE_MASTER_NUM, SLAVE_NUM>::manage_bundle (snoop_trans_bundle & cur_trans_bundle, unsigned initiator) {
   
   // This is deprecated, when the lack of a snoop response gives hints the initiator.
-  // To add ACE LITE nodes, this is impossible and the initiator is passed by the HOME through the PROT field
+  // To add ACE LITE nodes, this is impossible and the initiator is reported by the HOME (ace_home_snoop_inits)
   // Find the initiator
   /*
   unsigned initiator = MASTER_NUM+1;
@@ -323,6 +338,10 @@ void ace_coherency_checker<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, FULL_
   bool req_no_dirty = req_denies_dirty(coherent_init.snoop, is_read) || req_no_data_resp(coherent_init.snoop, is_read);
   // When dirty resp to req that denies dirty, writeback data to Mem
   if (got_dirty && req_no_dirty) {
+#ifdef TB_MEM_SIDE_CACHE
+    // A memory side cache absorbs the write-back, thus only the memory image gets updated
+    mem_img_write(coherent_init.addr, snoop_data.data, (ace5_::C_CACHE_WIDTH/8));
+#else
     // Setup scoreboards to reflect the responses
     msg_tb_wrap<ace5_::AddrPayload> temp_wr_req_tb;
     temp_wr_req_tb.dut_msg = coherent_init;
@@ -339,6 +358,7 @@ void ace_coherency_checker<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, FULL_
     wr_back_beat.dut_msg.last  = snoop_data.last;
     wr_back_beat.dut_msg.wstrb = -1;
     (*sb_wr_data_q)[tgt_mem].push_back(wr_back_beat);
+#endif
   }
   
   // Setup scoreboards to reflect the responses
@@ -368,7 +388,10 @@ void ace_coherency_checker<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, FULL_
       temp_rd_req_tb.dut_msg.barrier = 0;
       
       unsigned tgt_mem = mem_map_resolve(coherent_init.addr);
+      // A memory side cache fetches the entire line, if any, thus the Slave accepts it as a line access
+#ifndef TB_MEM_SIDE_CACHE
       (*sb_rd_req_q)[tgt_mem].push_back(temp_rd_req_tb);
+#endif
       
       // Generate expected responce from Mem
       ace5_::ReadPayload beat_expected;
@@ -377,7 +400,12 @@ void ace_coherency_checker<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, FULL_
       unsigned byte_count = 0;
       unsigned bytes_total = (ace5_::C_CACHE_WIDTH/8);
       while(byte_count<bytes_total) {
-        beat_expected.data |= ( ((ace5_::Data)(byte_count & 0xFF)) << ((ace5_::Data)(byte_count*8)));
+        ace5_::Data mem_byte = (byte_count & 0xFF);
+#ifdef TB_MEM_SIDE_CACHE
+        auto img_it = mem_img.find(coherent_init.addr + byte_count);
+        if (img_it != mem_img.end()) mem_byte = img_it->second;
+#endif
+        beat_expected.data |= ( mem_byte << ((ace5_::Data)((byte_count%(ace5_::C_DATA_CHAN_WIDTH/8))*8)));
         byte_count++;
     
         if(((byte_count%(ace5_::C_DATA_CHAN_WIDTH/8))==0) || (byte_count == bytes_total)) {
@@ -387,6 +415,10 @@ void ace_coherency_checker<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, FULL_
           msg_tb_wrap< ace5_::ReadPayload > temp_rd_resp_tb;
           temp_rd_resp_tb.dut_msg  = beat_expected;
           temp_rd_resp_tb.time_gen = sc_time_stamp();
+#ifdef TB_MEM_SIDE_CACHE
+          // A memory side cache may serve it from a line that a Write allocated
+          temp_rd_resp_tb.cache_resp = true;
+#endif
       
           (*sb_rd_resp_q)[initiator].push_back(temp_rd_resp_tb);
           beat_expected.data = 0;
@@ -395,9 +427,24 @@ void ace_coherency_checker<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, FULL_
     }
   } else { // Write Coherent access
     // The expected behavior is handled by the generator, being unchanged.
+#ifdef TB_MEM_SIDE_CACHE
+    // The line gets the data of the initiator, as its generator creates them
+    unsigned    master_id = initiator + SLAVE_NUM;
+    ace5_::Data wr_data;
+    if (ace5_::C_CACHE_WIDTH<64) wr_data = (((ace5_::Data) master_id) << (ace5_::C_CACHE_WIDTH - 8)) | ((ace5_::Data) 0x000000000000BEEF);
+    else                         wr_data = (((ace5_::Data) master_id) << (ace5_::C_CACHE_WIDTH - 8)) | ((ace5_::Data) 0x0000BEEFDEADBEEF);
+    mem_img_write(coherent_init.addr, wr_data, ((coherent_init.len.to_uint()+1) << coherent_init.size.to_uint()));
+#endif
   }
 };
 
+#ifdef TB_MEM_SIDE_CACHE
+template <unsigned int RD_M_LANES, unsigned int RD_S_LANES, unsigned int WR_M_LANES, unsigned int WR_S_LANES, unsigned int FULL_MASTER_NUM, unsigned int LITE_MASTER_NUM, unsigned int SLAVE_NUM>
+void ace_coherency_checker<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, FULL_MASTER_NUM, LITE_MASTER_NUM, SLAVE_NUM>::mem_img_write (ace5_::Addr addr, ace5_::Data data, unsigned bytes) {
+  for (unsigned i=0; i<bytes; ++i) mem_img[addr+i] = ((data >> (i*8)) & 0xFF).to_uint();
+};
+#endif
+
 
 // ------------------------ //
 // --- VERIFY Functions --- //
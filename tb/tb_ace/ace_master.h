@@ -701,6 +701,7 @@ void ace_master<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, MASTER_NUM, SLAV
     
       // Push it to Scoreboard
       sb_lock->lock();
+#ifndef TB_MEM_SIDE_CACHE
       unsigned target_mem = mem_map_resolve(cache_req.addr);
       msg_tb_wrap<ace5_::AddrPayload> temp_wr_coherent_req_tb;
       temp_wr_coherent_req_tb.is_read         = false;
@@ -718,6 +719,16 @@ void ace_master<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, MASTER_NUM, SLAV
       temp_wr_data_tb.time_gen = sc_time_stamp();
     
       (*sb_wr_data_q)[target_mem].push_back(temp_wr_data_tb);
+#else
+      // A memory side cache may absorb the Write and respond on its own. The coherency checker
+      //   keeps its data in the memory image, to verify the Reads that follow
+      msg_tb_wrap<ace5_::WRespPayload> temp_wr_coherent_resp_tb;
+      temp_wr_coherent_resp_tb.dut_msg.id   = cache_req.id;
+      temp_wr_coherent_resp_tb.dut_msg.resp = mem_map_resolve(cache_req.addr);
+      temp_wr_coherent_resp_tb.cache_resp   = true;
+      temp_wr_coherent_resp_tb.time_gen     = sc_time_stamp();
+      (*sb_wr_resp_q)[MASTER_ID-SLAVE_NUM].push_back(temp_wr_coherent_resp_tb);
+#endif
       sb_lock->unlock();
     
       // Push into order queue - Reorder check extension
@@ -1367,8 +1378,12 @@ void ace_master<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, MASTER_NUM, SLAV
   //if (sb_ord_req.snoop == 0) {
     while (j<(*sb_rd_resp_q)[MASTER_ID-SLAVE_NUM].size()){
       msg_tb_wrap< ace5_::ReadPayload > sb_resp = (*sb_rd_resp_q)[MASTER_ID-SLAVE_NUM][j];
+      
+      // A line that a Write allocated in a memory side cache responds OKAY instead of the Slave ID
+      ace5_::ReadPayload sb_cache_resp = sb_resp.dut_msg;
+      sb_cache_resp.resp = sb_cache_resp.resp & 0xC;
     
-      if (eq_rd_data(rcv_rd_resp, sb_resp.dut_msg)){
+      if (eq_rd_data(rcv_rd_resp, sb_resp.dut_msg) || (sb_resp.cache_resp && eq_rd_data(rcv_rd_resp, sb_cache_resp))){
         if (sb_resp.dut_msg.last) {
           rd_resp_delay += ((sc_time_stamp() - sb_resp.time_gen) / clk_period) - 1;
           rd_resp_count++;
@@ -1440,7 +1455,12 @@ void ace_master<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, MASTER_NUM, SLAV
       // Slave must sneak its ID into the first data byte of every beat (aka data[0]).
       unsigned dst = mem_map_resolve(sb_ord_req.addr);
       is_coherent = (sb_ord_req.snoop || sb_ord_req.domain.xor_reduce());
+#ifdef TB_MEM_SIDE_CACHE
+      // A memory side cache may respond OKAY to coherent Writes on its own
+      reorder = (dst  == rcv_wr_resp.resp) || (is_coherent && (rcv_wr_resp.resp == 0)) ? 0 : 1;
+#else
       reorder = (dst  == rcv_wr_resp.resp) ? 0 : 1;
+#endif
       sb_wr_order_q.erase(sb_wr_order_q.begin()+j);
       break;
     }
@@ -1455,7 +1475,11 @@ void ace_master<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, MASTER_NUM, SLAV
   while (j<(*sb_wr_resp_q)[MASTER_ID-SLAVE_NUM].size()){
     msg_tb_wrap< ace5_::WRespPayload > sb_resp = (*sb_wr_resp_q)[MASTER_ID-SLAVE_NUM][j];
     
-    if (eq_wr_resp(sb_resp.dut_msg, rcv_wr_resp)){
+    // A memory side cache that absorbs the Write responds OKAY instead of the Slave ID
+    ace5_::WRespPayload sb_cache_resp = sb_resp.dut_msg;
+    sb_cache_resp.resp = 0;
+    
+    if (eq_wr_resp(sb_resp.dut_msg, rcv_wr_resp) || (sb_resp.cache_resp && eq_wr_resp(sb_cache_resp, rcv_wr_resp))){
       
       wr_resp_delay += ((sc_time_stamp() - sb_resp.time_gen) / clk_period) - 1;
       wr_resp_count++;
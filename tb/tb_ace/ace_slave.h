@@ -6,6 +6,7 @@
 #include "../../src/include/dnp_ace_v0.h"
 
 #include <deque>
+#include <map>
 #include <queue>
 
 #include <iostream>
@@ -62,6 +63,14 @@ SC_MODULE(ace_slave) {
   
   std::deque<ace5_::AddrPayload>   wr_to_get_resp;
   
+#ifdef TB_MEM_SIDE_CACHE
+  // A memory side cache fills and writes back entire lines on its own. The Slave keeps the bytes it
+  //   writes back, a byte per address, and serves them to its fills. Bytes never written keep the pattern
+  std::map<ace5_::Addr, unsigned char> mem_lines;
+  std::deque<bool>                     wr_from_cache; // Per Write in wr_to_get_resp
+  unsigned                             wr_cache_bytes; // Bytes of the current Write from the cache, received so far
+#endif
+  
   // Read Response Generator
   int rd_resp_val;
   int rd_resp_generated;
@@ -83,13 +92,18 @@ SC_MODULE(ace_slave) {
   
   // Functions
 	void do_cycle();
-	void gen_rd_resp(ace5_::AddrPayload   &rcv_rd_req );
+	void gen_rd_resp(ace5_::AddrPayload   &rcv_rd_req, bool from_cache);
 	void gen_wr_resp(unsigned wr_initiator);
   
-	bool verify_rd_req(ace5_::AddrPayload    &rcv_rd_req);
-	bool verify_wr_req(ace5_::AddrPayload    &rcv_wr_req);
+	bool verify_rd_req(ace5_::AddrPayload    &rcv_rd_req, bool &from_cache);
+	bool verify_wr_req(ace5_::AddrPayload    &rcv_wr_req, bool &from_cache);
 	bool verify_wr_data(ace5_::WritePayload  &rcv_wr_data, unsigned &wr_initiator);
 	
+	bool is_line_req(ace5_::AddrPayload &rcv_req);
+#ifdef TB_MEM_SIDE_CACHE
+	void store_wr_data(ace5_::WritePayload &rcv_wr_data);
+#endif
+	
 	bool eq_rd_req (ace5_::AddrPayload &rcv_rd_req  , ace5_::AddrPayload &sb_rd_req);
 	bool eq_wr_req (ace5_::AddrPayload &rcv_wr_req  , ace5_::AddrPayload &sb_wr_req);
 	bool eq_wr_data(ace5_::WritePayload &rcv_wr_data, ace5_::WritePayload &sb_wr_data);
@@ -136,6 +150,10 @@ void ace_slave<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, MASTER_NUM, SLAVE
   error_sb_wr_req_not_found  = 0;
   error_sb_wr_data_not_found = 0;
   
+#ifdef TB_MEM_SIDE_CACHE
+  wr_cache_bytes = 0;
+#endif
+  
   ar_in.Reset();
   r_out.Reset();
   aw_in.Reset();
@@ -152,10 +170,11 @@ void ace_slave<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, MASTER_NUM, SLAVE
       ace5_::AddrPayload rcv_rd_req;
       if (ar_in.PopNB(rcv_rd_req)) {
         sc_time this_gen_time;
-        if (rcv_rd_req.snoop==0) verify_rd_req(rcv_rd_req);
+        bool from_cache = false;
+        if (rcv_rd_req.snoop==0) verify_rd_req(rcv_rd_req, from_cache);
         rd_req_ej++;
   
-        gen_rd_resp(rcv_rd_req);
+        gen_rd_resp(rcv_rd_req, from_cache);
       }
     }
     
@@ -164,8 +183,12 @@ void ace_slave<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, MASTER_NUM, SLAVE
     if (rnd_val_sink >= AXI_STALL_RATE_WR) {
       ace5_::AddrPayload rcv_wr_req;
       if (aw_in.PopNB(rcv_wr_req)) {
-        verify_wr_req(rcv_wr_req);
+        bool from_cache = false;
+        verify_wr_req(rcv_wr_req, from_cache);
         wr_to_get_resp.push_back(rcv_wr_req);
+#ifdef TB_MEM_SIDE_CACHE
+        wr_from_cache.push_back(from_cache);
+#endif
         wr_req_ej++;
       }
     }
@@ -174,7 +197,12 @@ void ace_slave<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, MASTER_NUM, SLAVE
       ace5_::WritePayload rcv_wr_data;
       if (w_in.PopNB(rcv_wr_data)) {
         unsigned wr_initiator = -1;
+#ifdef TB_MEM_SIDE_CACHE
+        if (wr_from_cache.front()) store_wr_data(rcv_wr_data);
+        else                       verify_wr_data(rcv_wr_data, wr_initiator);
+#else
         verify_wr_data(rcv_wr_data, wr_initiator);
+#endif
         wr_data_ej++;
   
         if (rcv_wr_data.last) gen_wr_resp(wr_initiator);
@@ -219,7 +247,7 @@ void ace_slave<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, MASTER_NUM, SLAVE
 // --- GENERATOR Functions --- //
 // --------------------------- //
 template <unsigned int RD_M_LANES, unsigned int RD_S_LANES, unsigned int WR_M_LANES, unsigned int WR_S_LANES, unsigned int MASTER_NUM, unsigned int SLAVE_NUM>
-void ace_slave<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, MASTER_NUM, SLAVE_NUM>::gen_rd_resp(ace5_::AddrPayload &rcv_rd_req) {
+void ace_slave<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, MASTER_NUM, SLAVE_NUM>::gen_rd_resp(ace5_::AddrPayload &rcv_rd_req, bool from_cache) {
   sb_lock->lock();
   ace5_::ReadPayload cur_beat;
   ace5_::ReadPayload beat_at_master;
@@ -239,7 +267,15 @@ void ace_slave<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, MASTER_NUM, SLAVE
   beat_at_master.data = 0;
   
   while(byte_count<bytes_total) {
-    cur_beat.data |= ( ((ace5_::Data)(byte_count & 0xFF)) << ((ace5_::Data)(s_ptr*8)));
+    ace5_::Data mem_byte = (byte_count & 0xFF);
+#ifdef TB_MEM_SIDE_CACHE
+    // The fills of the memory side cache get the lines it wrote back
+    if (from_cache) {
+      auto line_it = mem_lines.find(rcv_rd_req.addr + byte_count);
+      if (line_it != mem_lines.end()) mem_byte = line_it->second;
+    }
+#endif
+    cur_beat.data |= ( mem_byte << ((ace5_::Data)(s_ptr*8)));
     byte_count++;
     
     s_ptr = (rcv_rd_req.burst==FIXED) ? ((s_ptr+1)%(1<<s_size)) + s_init_ptr
@@ -262,6 +298,9 @@ void ace_slave<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, MASTER_NUM, SLAVE
   // Create Response
   ace5_::AddrPayload rcv_wr_req = wr_to_get_resp.front();
   wr_to_get_resp.pop_front();
+#ifdef TB_MEM_SIDE_CACHE
+  wr_from_cache.pop_front();
+#endif
   
   ace5_::WRespPayload temp_wr_resp;
   temp_wr_resp.id   = rcv_wr_req.id;
@@ -289,7 +328,7 @@ void ace_slave<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, MASTER_NUM, SLAVE
 // --- VERIFY Functions --- //
 // ------------------------ //
 template <unsigned int RD_M_LANES, unsigned int RD_S_LANES, unsigned int WR_M_LANES, unsigned int WR_S_LANES, unsigned int MASTER_NUM, unsigned int SLAVE_NUM>
-bool ace_slave<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, MASTER_NUM, SLAVE_NUM>::verify_rd_req (ace5_::AddrPayload &rcv_rd_req) {
+bool ace_slave<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, MASTER_NUM, SLAVE_NUM>::verify_rd_req (ace5_::AddrPayload &rcv_rd_req, bool &from_cache) {
   bool verified = true;
   sb_lock->lock();
   bool found=false;
@@ -305,7 +344,14 @@ bool ace_slave<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, MASTER_NUM, SLAVE
     j++;
   }
   
-  if(!found){
+#ifdef TB_MEM_SIDE_CACHE
+  // A memory side cache fills entire lines on its own
+  from_cache = !found && is_line_req(rcv_rd_req);
+#endif
+  
+  if (from_cache) {
+    std::cout << "[Slave " << SLAVE_ID <<"] " << "RD Request   : "<< rcv_rd_req << " from the memory side cache @" << sc_time_stamp() << "\n";
+  } else if(!found){
     std::cout << "ERR : [Slave " << SLAVE_ID <<"] " << "RD Request   : "<< rcv_rd_req << " . NOT FOUND! @" << sc_time_stamp() << "\n";
     std::cout << "ERR :   [Slave " << SLAVE_ID <<"] " << "-SB_front - "<< (*sb_rd_req_q)[SLAVE_ID].front() << "\n";
     error_sb_rd_req_not_found++;
@@ -321,7 +367,7 @@ bool ace_slave<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, MASTER_NUM, SLAVE
 }; // End of READ Req Verify
 
 template <unsigned int RD_M_LANES, unsigned int RD_S_LANES, unsigned int WR_M_LANES, unsigned int WR_S_LANES, unsigned int MASTER_NUM, unsigned int SLAVE_NUM>
-bool ace_slave<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, MASTER_NUM, SLAVE_NUM>::verify_wr_req (ace5_::AddrPayload &rcv_wr_req) {
+bool ace_slave<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, MASTER_NUM, SLAVE_NUM>::verify_wr_req (ace5_::AddrPayload &rcv_wr_req, bool &from_cache) {
   bool verified = true;
   sb_lock->lock();
   bool found=false;
@@ -337,7 +383,14 @@ bool ace_slave<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, MASTER_NUM, SLAVE
     j++;
   }
   
-  if(!found){
+#ifdef TB_MEM_SIDE_CACHE
+  // A memory side cache writes back entire lines on its own
+  from_cache = !found && is_line_req(rcv_wr_req);
+#endif
+  
+  if (from_cache) {
+    std::cout << "[Slave " << SLAVE_ID <<"] " << "WR Request   : "<< rcv_wr_req << " from the memory side cache @" << sc_time_stamp() << "\n";
+  } else if(!found){
     std::cout << "\n";
     std::cout << "ERR : [Slave " << SLAVE_ID <<"] " << "WR Request   : "<< rcv_wr_req << " . NOT FOUND! @" << sc_time_stamp() << "\n";
     std::cout << "ERR :   [Slave " << SLAVE_ID <<"] " << "-SB_front - "<< (*sb_wr_req_q)[SLAVE_ID].front() << "\n";
@@ -396,6 +449,34 @@ bool ace_slave<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, MASTER_NUM, SLAVE
   return verified;
 }; // End of WRITE Data Verify
 
+// An INCR access of an entire, aligned cache line, as the memory side cache performs
+template <unsigned int RD_M_LANES, unsigned int RD_S_LANES, unsigned int WR_M_LANES, unsigned int WR_S_LANES, unsigned int MASTER_NUM, unsigned int SLAVE_NUM>
+bool ace_slave<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, MASTER_NUM, SLAVE_NUM>::is_line_req (ace5_::AddrPayload &rcv_req) {
+  unsigned line_bytes = (ace5_::C_CACHE_WIDTH/8);
+  return (rcv_req.burst == enc_::AXBURST::INCR) &&
+         (((rcv_req.len.to_uint()+1) << rcv_req.size.to_uint()) == line_bytes) &&
+         ((rcv_req.addr.to_uint() % line_bytes) == 0);
+};
+
+#ifdef TB_MEM_SIDE_CACHE
+// Keeps the enabled bytes of a Write from the memory side cache
+template <unsigned int RD_M_LANES, unsigned int RD_S_LANES, unsigned int WR_M_LANES, unsigned int WR_S_LANES, unsigned int MASTER_NUM, unsigned int SLAVE_NUM>
+void ace_slave<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, MASTER_NUM, SLAVE_NUM>::store_wr_data (ace5_::WritePayload &rcv_wr_data) {
+  sb_lock->lock();
+  ace5_::AddrPayload cur_req   = wr_to_get_resp.front();
+  ace5_::Addr        beat_addr = cur_req.addr + wr_cache_bytes;
+  for (unsigned i=0; i<WR_S_LANES; ++i) {
+    if ((rcv_wr_data.wstrb.to_uint() >> i) & 1) {
+      mem_lines[(beat_addr & ~((ace5_::Addr)(WR_S_LANES-1))) + i] = ((rcv_wr_data.data >> (i*8)) & 0xFF).to_uint();
+    }
+  }
+  wr_cache_bytes = rcv_wr_data.last.to_uint() ? 0 : (wr_cache_bytes + (1<<cur_req.size.to_uint()));
+  std::cout<< "[Slave " << SLAVE_ID <<"] " << "WR Data   : "<< rcv_wr_data << " from the memory side cache @" << sc_time_stamp() << "\n";
+  std::cout.flush();
+  sb_lock->unlock();
+}; // End of WRITE Data Store
+#endif
+
 
 template <unsigned int RD_M_LANES, unsigned int RD_S_LANES, unsigned int WR_M_LANES, unsigned int WR_S_LANES, unsigned int MASTER_NUM, unsigned int SLAVE_NUM>
 bool ace_slave<RD_M_LANES, RD_S_LANES, WR_M_LANES, WR_S_LANES, MASTER_NUM, SLAVE_NUM>::eq_rd_req (ace5_::AddrPayload &rcv_rd_req, ace5_::AddrPayload &sb_rd_req) {
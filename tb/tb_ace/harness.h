@@ -27,9 +27,16 @@ SC_MODULE(harness) {
   const int CLK_PERIOD = 5;
   const int GEN_CYCLES = 2 * 1000;
   
-  const int AXI_GEN_RATE_RD[smpl_cfg::ALL_MASTER_NUM]    = {20, 20, 20, 20};
-  const int AXI_GEN_RATE_WR[smpl_cfg::ALL_MASTER_NUM]    = {20, 20, 20, 20};
-  const int ACE_GEN_RATE_CACHE[smpl_cfg::ALL_MASTER_NUM] = {10, 10, 10, 10};
+  // Generation rates (%) may be overridden at compile time, e.g. for load-latency sweeps
+#ifndef BENCH_AXI_GEN_RATE
+  #define BENCH_AXI_GEN_RATE 20
+#endif
+#ifndef BENCH_ACE_GEN_RATE
+  #define BENCH_ACE_GEN_RATE 10
+#endif
+  const int AXI_GEN_RATE_RD[smpl_cfg::ALL_MASTER_NUM]    = {BENCH_AXI_GEN_RATE, BENCH_AXI_GEN_RATE, BENCH_AXI_GEN_RATE, BENCH_AXI_GEN_RATE};
+  const int AXI_GEN_RATE_WR[smpl_cfg::ALL_MASTER_NUM]    = {BENCH_AXI_GEN_RATE, BENCH_AXI_GEN_RATE, BENCH_AXI_GEN_RATE, BENCH_AXI_GEN_RATE};
+  const int ACE_GEN_RATE_CACHE[smpl_cfg::ALL_MASTER_NUM] = {BENCH_ACE_GEN_RATE, BENCH_ACE_GEN_RATE, BENCH_ACE_GEN_RATE, BENCH_ACE_GEN_RATE};
   
   const int AXI_STALL_RATE_RD = 00;
   const int AXI_STALL_RATE_WR = 00;
@@ -518,7 +525,7 @@ SC_MODULE(harness) {
     }
     
     
-    for (int i=0; i<smpl_cfg::ALL_MASTER_NUM; ++i) {
+    for (int i=0; i<smpl_cfg::FULL_MASTER_NUM; ++i) {
       rd_delay_full_sum_p_m[i] += master[i]->rd_resp_delay;
       rd_trans_sum_p_m[i]      += master[i]->rd_resp_count;
       
@@ -536,31 +543,54 @@ SC_MODULE(harness) {
       wr_data_count_glob += master[i]->wr_resp_data_count;
     }
     
+    for (int i=0; i<smpl_cfg::LITE_MASTER_NUM; ++i) {
+      unsigned m = i+smpl_cfg::FULL_MASTER_NUM;
+      rd_delay_full_sum_p_m[m] += master_lite[i]->rd_resp_delay;
+      rd_trans_sum_p_m[m]      += master_lite[i]->rd_resp_count;
+      
+      rd_delay_full_sum_glob += master_lite[i]->rd_resp_delay;
+      rd_trans_sum_glob      += master_lite[i]->rd_resp_count;
+      
+      rd_data_count_glob += master_lite[i]->rd_resp_data_count;
+      
+      wr_delay_full_sum_p_m[m] += master_lite[i]->wr_resp_delay;
+      wr_trans_sum_p_m[m]      += master_lite[i]->wr_resp_count;
+      
+      wr_delay_full_sum_glob += master_lite[i]->wr_resp_delay;
+      wr_trans_sum_glob      += master_lite[i]->wr_resp_count;
+      
+      wr_data_count_glob += master_lite[i]->wr_resp_data_count;
+    }
+    
     sc_time this_clk_period = clk.period();
     unsigned long long int total_cycles = sc_time_stamp() / this_clk_period;
-    /*
-    std::cout << "Delay Per Master Slave(delay, Throughput) :\n";
-    for (int i=0; i<smpl_cfg::MASTER_NUM; i++) {
-      std::cout << "M" << i << " RD: " << (rd_trans_sum_p_m[i] ? ((float)rd_delay_full_sum_p_m[i] / (float)rd_trans_sum_p_m[i]) : 0)
+    
+    std::cout << "Delay Per Master (delay, Throughput) :\n";
+    for (int i=0; i<smpl_cfg::ALL_MASTER_NUM; i++) {
+      std::cout << "M" << i+smpl_cfg::SLAVE_NUM << " RD: " << (rd_trans_sum_p_m[i] ? ((float)rd_delay_full_sum_p_m[i] / (float)rd_trans_sum_p_m[i]) : 0)
                                        << ", "
-                                       << (rd_trans_sum_p_m[i] ? ((float)master[i]->rd_resp_data_count / (float)master[i]->last_rd_sinked_cycle) : 0)
-                                       << "\n   WR: "
+                                       << (rd_trans_sum_p_m[i] ? ((float)rd_trans_sum_p_m[i] / (float)total_cycles) : 0)
+                                       << "\n    WR: "
                                        << (wr_trans_sum_p_m[i] ? ((float)wr_delay_full_sum_p_m[i] / (float)wr_trans_sum_p_m[i]) : 0)
                                        << ", "
-                                       << (wr_trans_sum_p_m[i] ? ((float)master[i]->wr_resp_data_count / (float)total_cycles) : 0)
+                                       << (wr_trans_sum_p_m[i] ? ((float)wr_trans_sum_p_m[i] / (float)total_cycles) : 0)
                                        << "\n";
     }
     
-    float rd_delay_full_total     = ((float)rd_delay_full_sum_glob / (float)rd_trans_sum_glob);
-    float wr_delay_full_total     = ((float)wr_delay_full_sum_glob / (float)wr_trans_sum_glob);
+    float rd_delay_full_total     = rd_trans_sum_glob ? ((float)rd_delay_full_sum_glob / (float)rd_trans_sum_glob) : 0;
+    float wr_delay_full_total     = wr_trans_sum_glob ? ((float)wr_delay_full_sum_glob / (float)wr_trans_sum_glob) : 0;
     
-    float rd_throughput_total     = ((float)rd_data_count_glob      / (float)total_cycles) / (float)smpl_cfg::MASTER_NUM;
-    float wr_throughput_total     = ((float)wr_data_count_glob      / (float)total_cycles) / (float)smpl_cfg::MASTER_NUM;
+    float rd_throughput_total     = ((float)rd_data_count_glob      / (float)total_cycles) / (float)smpl_cfg::ALL_MASTER_NUM;
+    float wr_throughput_total     = ((float)wr_data_count_glob      / (float)total_cycles) / (float)smpl_cfg::ALL_MASTER_NUM;
     
+    // Single line summary, to be gathered by load-latency sweeps (see the bench target of the examples)
     std::cout << "                               (RD, WR) \n";
     std::cout << "Full     Avg delay(cycles)      : " << rd_delay_full_total << ", "<< wr_delay_full_total << "\n";
-    std::cout << "Throughput   (flits/cycle/node) : " << rd_throughput_total << ", "<< wr_throughput_total << "\n";
-    */
+    std::cout << "Throughput   (beats/cycle/node) : " << rd_throughput_total << ", "<< wr_throughput_total << "\n";
+    std::cout << "BENCH rate_axi=" << BENCH_AXI_GEN_RATE << " rate_ace=" << BENCH_ACE_GEN_RATE
+              << " rd_lat=" << rd_delay_full_total << " wr_lat=" << wr_delay_full_total
+              << " rd_thr=" << rd_throughput_total << " wr_thr=" << wr_throughput_total << "\n";
+    
     std::cout << __VERSION__ << "\n";
     std::cout.flush();
     
@@ -0,0 +1,228 @@
+#ifndef SYNTH_IC_HARNESS_H
+#define SYNTH_IC_HARNESS_H
+
+#include "systemc.h"
+
+#include <mc_scverify.h>
+
+#define NVHLS_VERIFY_BLOCKS (ic_top)
+
+#include "stdlib.h"
+#include <string>
+
+#include "../../tb/tb_noc_synth/synth_node.h"
+
+#include <iostream>
+
+// Traffic parameters may be overridden at compile time, e.g. for load-latency sweeps
+#ifndef BENCH_PATTERN
+  #define BENCH_PATTERN SYNTH_UNIFORM
+#endif
+#ifndef BENCH_GEN_RATE
+  #define BENCH_GEN_RATE 20
+#endif
+#ifndef BENCH_PKT_FLITS
+  #define BENCH_PKT_FLITS 4
+#endif
+#ifndef BENCH_HOTSPOT_RATE
+  #define BENCH_HOTSPOT_RATE 20
+#endif
+
+SC_MODULE(harness) {
+  const int CLK_PERIOD    = 10;
+  const int WARMUP_CYCLES = 1000;
+  const int GEN_CYCLES    = 5 * 1000;
+  const int DRAIN_CYCLES  = GEN_CYCLES/10;
+
+  // The hotspot is a central node, as a memory controller at the middle of the mesh
+  const unsigned HOTSPOT = (ic_top::DIM_Y/2)*ic_top::DIM_X + (ic_top::DIM_X/2);
+
+  typedef synth_node<2, ic_top::DIM_X, ic_top::DIM_Y> node_t;
+
+  sc_clock        clk;
+  sc_signal<bool> rst_n;
+
+  sc_signal<bool> stop_gen;
+
+  node_t *node[ic_top::NODES];
+
+  CCS_DESIGN(ic_top) interconnect;
+
+  Connections::Combinational<ic_top::flit_t>  *chan_inj[ic_top::NODES][2];
+  Connections::Combinational<ic_top::flit_t>  *chan_ej[ic_top::NODES][2];
+
+#if BENCH_RC==4
+  // Loads the routing tables
+  Connections::Out<rt_cfg_t>           rt_cfg_out;
+  Connections::In<rt_cfg_t>            rt_cfg_in;
+  Connections::Combinational<rt_cfg_t> chan_rt_cfg_in;
+  Connections::Combinational<rt_cfg_t> chan_rt_cfg_out;
+#endif
+
+  SC_CTOR(harness) :
+    clk("clock",10,SC_NS,0.5,0.0,SC_NS),
+    rst_n("rst_n"),
+    stop_gen("stop_gen"),
+
+    interconnect("interconnect")
+  {
+    std::cout << "---  Binding...  ---\n";
+    std::cout.flush();
+
+    interconnect.clk(clk);
+    interconnect.rst_n(rst_n);
+
+    for (unsigned n=0; n<ic_top::NODES; ++n) {
+      node[n] = new node_t(sc_gen_unique_name("node"));
+      node[n]->NODE_ID       = n;
+      node[n]->GEN_RATE      = BENCH_GEN_RATE;
+      node[n]->PATTERN       = BENCH_PATTERN;
+      node[n]->PKT_FLITS     = BENCH_PKT_FLITS;
+      node[n]->HOTSPOT       = HOTSPOT;
+      node[n]->HOTSPOT_RATE  = BENCH_HOTSPOT_RATE;
+      node[n]->WARMUP_CYCLES = WARMUP_CYCLES;
+      node[n]->MEASURE_CYCLES = GEN_CYCLES;
+
+      node[n]->clk(clk);
+      node[n]->rst_n(rst_n);
+      node[n]->stop_gen(stop_gen);
+
+      for (int p=0; p<2; ++p) {
+        chan_inj[n][p] = new Connections::Combinational<ic_top::flit_t> (sc_gen_unique_name("chan_inj"));
+        chan_ej[n][p]  = new Connections::Combinational<ic_top::flit_t> (sc_gen_unique_name("chan_ej"));
+
+        node[n]->inj_out[p](*chan_inj[n][p]);
+        interconnect.inj_in[n][p](*chan_inj[n][p]);
+
+        interconnect.ej_out[n][p](*chan_ej[n][p]);
+        node[n]->ej_in[p](*chan_ej[n][p]);
+      }
+    }
+#if BENCH_RC==4
+    rt_cfg_out(chan_rt_cfg_in);
+    interconnect.rt_cfg_in(chan_rt_cfg_in);
+    interconnect.rt_cfg_out(chan_rt_cfg_out);
+    rt_cfg_in(chan_rt_cfg_out);
+#endif
+    std::cout << "---  Binding Succeed  ---\n";
+    std::cout.flush();
+
+    Connections::set_sim_clk(&clk);
+
+    SC_THREAD(harness_job);
+    sensitive << clk.posedge_event();
+  } // End of Constructor
+
+  void harness_job() {
+    std::cout << "--- Simulation is Starting @" << sc_time_stamp() << " ---\n";
+    std::cout.flush();
+    rst_n.write(false);
+    stop_gen.write(true);
+    wait(CLK_PERIOD*2, SC_NS);
+
+    rst_n.write(true);
+    wait(CLK_PERIOD*2, SC_NS);
+
+#if BENCH_RC==4
+    // Load XY routes in the routing tables before any traffic. Each update returns after passing every table
+    rt_cfg_out.Reset();
+    rt_cfg_in.Reset();
+    const unsigned UPD_NUM = ic_top::NODES*ic_top::NODES;
+    unsigned upd_sent = 0, upd_returned = 0;
+    while (upd_returned < UPD_NUM) {
+      if ((upd_sent < UPD_NUM) && rt_cfg_out.PushNB(xy_route(upd_sent / ic_top::NODES, upd_sent % ic_top::NODES))) upd_sent++;
+      rt_cfg_t upd_ret;
+      if (rt_cfg_in.PopNB(upd_ret)) upd_returned++;
+      wait();
+    }
+    std::cout << "--- Routing tables loaded @" << sc_time_stamp() << " ---\n";
+#endif
+
+    stop_gen.write(false);
+    wait(CLK_PERIOD*(WARMUP_CYCLES+GEN_CYCLES), SC_NS);
+
+    stop_gen.write(true);
+    std::cout << "--- Generation Stopped @" << sc_time_stamp() << " ---\n";
+    std::cout.flush();
+
+    // Drain
+    bool all_drained = false;
+    do {
+      unsigned long long int generated = 0, ejected = 0;
+      for (unsigned n=0; n<ic_top::NODES; ++n) {
+        generated += node[n]->pkt_generated;
+        ejected   += node[n]->pkt_ejected;
+      }
+      all_drained = (generated == ejected);
+      if (all_drained) {
+        std::cout << "--- Everything Drained @" << sc_time_stamp() << " ---\n";
+      } else {
+        std::cout << "--- Wait to drain (Packets: " << generated-ejected << ") @" << sc_time_stamp() << " ---\n";
+        wait(CLK_PERIOD*DRAIN_CYCLES, SC_NS);
+      }
+      std::cout.flush();
+    } while(!all_drained);
+
+    //--- Stats ---//
+    int errors = 0;
+    unsigned long long int lat_count = 0, lat_sum = 0, lat_max = 0, flits = 0;
+    unsigned long long int lat_hist[node_t::LAT_BINS];
+    for (unsigned b=0; b<node_t::LAT_BINS; ++b) lat_hist[b] = 0;
+    for (unsigned n=0; n<ic_top::NODES; ++n) {
+      errors    += node[n]->error_wrong_dst;
+      lat_count += node[n]->lat_count;
+      lat_sum   += node[n]->lat_sum;
+      flits     += node[n]->flit_ejected_measured;
+      if (node[n]->lat_max > lat_max) lat_max = node[n]->lat_max;
+      for (unsigned b=0; b<node_t::LAT_BINS; ++b) lat_hist[b] += node[n]->lat_hist[b];
+    }
+    float lat_avg    = lat_count ? ((float)lat_sum / (float)lat_count) : 0;
+    float throughput = ((float)flits / (float)GEN_CYCLES) / (float)ic_top::NODES;
+    unsigned lat_p50  = lat_percentile(lat_hist, lat_count, 500);
+    unsigned lat_p99  = lat_percentile(lat_hist, lat_count, 990);
+    unsigned lat_p999 = lat_percentile(lat_hist, lat_count, 999);
+
+    std::cout << "Errors (wrong destination)  : " << errors << "\n";
+    std::cout << "Avg packet latency (cycles) : " << lat_avg << "\n";
+    std::cout << "Max packet latency (cycles) : " << lat_max << "\n";
+    std::cout << "Packet latency p50/p99/p99.9: " << lat_p50 << " / " << lat_p99 << " / " << lat_p999 << "\n";
+    std::cout << "Throughput (flits/cycle/node): " << throughput << "\n";
+    // Single line summary, to be gathered by load-latency sweeps (see the bench target of the example)
+    std::cout << "BENCH rc=" << BENCH_RC << " age=" << BENCH_AGE << " pattern=" << BENCH_PATTERN << " rate=" << BENCH_GEN_RATE
+              << " lat=" << lat_avg << " p50=" << lat_p50 << " p99=" << lat_p99 << " p999=" << lat_p999
+              << " lat_max=" << lat_max << " thr=" << throughput << "\n";
+
+    std::cout << "\n Simulation Finished! \n";
+    std::cout.flush();
+    sc_stop();
+  }
+
+  // The latency below which lie per_mille of the packets. The last bin is reported as is
+  unsigned lat_percentile (const unsigned long long int hist[], unsigned long long int count, unsigned per_mille) {
+    unsigned long long int below = 0;
+    for (unsigned b=0; b<node_t::LAT_BINS; ++b) {
+      below += hist[b];
+      if (below*1000 >= count*per_mille) return b;
+    }
+    return node_t::LAT_BINS-1;
+  };
+
+#if BENCH_RC==4
+  // The XY route of the router with table rt towards dst. Packets eject at port 4
+  rt_cfg_t xy_route (unsigned rt, unsigned dst) {
+    unsigned rt_x  = rt  % ic_top::DIM_X, rt_y  = rt  / ic_top::DIM_X;
+    unsigned dst_x = dst % ic_top::DIM_X, dst_y = dst / ic_top::DIM_X;
+    rt_cfg_t upd;
+    upd.rt_id = rt;
+    upd.all   = false;
+    upd.dst   = dst;
+    upd.port  = (dst_x>rt_x) ? 1 :
+                (dst_x<rt_x) ? 0 :
+                (dst_y>rt_y) ? 3 :
+                (dst_y<rt_y) ? 2 : 4;
+    return upd;
+  };
+#endif
+}; // End of harness
+
+#endif // SYNTH_IC_HARNESS_H
@@ -0,0 +1,159 @@
+#ifndef SYNTH_NODE_H
+#define SYNTH_NODE_H
+
+#include "systemc.h"
+#include "nvhls_connections.h"
+
+#include "../../src/include/flit_axi.h"
+
+#include <deque>
+#include <iostream>
+
+// Synthetic traffic patterns of a DIM_X x DIM_Y mesh
+//   SYNTH_UNIFORM   : Uniform random destinations
+//   SYNTH_TRANSPOSE : Node (x,y) sends to (y,x). Nodes on the diagonal do not send
+//   SYNTH_HOTSPOT   : HOTSPOT_RATE% of the packets go to the HOTSPOT node, the rest are uniform
+enum SYNTH_PATTERN {
+  SYNTH_UNIFORM   = 0,
+  SYNTH_TRANSPOSE = 1,
+  SYNTH_HOTSPOT   = 2
+};
+
+// Generator and sink of synthetic traffic, injected directly into a router as flits.
+//   Packets of PKT_FLITS flits are generated at GEN_RATE% flits per cycle, and alternate randomly between
+//   the RD and WR injection ports. Each flit carries its generation cycle in its last phit, thus latency
+//   is measured from generation to the ejection of the tail, including the source queueing.
+//   Only packets generated after WARMUP_CYCLES are measured, and throughput counts the flits ejected within
+//   the next MEASURE_CYCLES. The measured latencies are also gathered in a histogram, for the tail latency.
+template <unsigned PHIT_NUM, unsigned DIM_X, unsigned DIM_Y>
+SC_MODULE(synth_node) {
+  typedef flit_dnp<PHIT_NUM> flit_t;
+
+  sc_in_clk    clk;
+  sc_in <bool> rst_n;
+  sc_in <bool> stop_gen;
+
+  Connections::Out<flit_t>  inj_out[2];
+  Connections::In<flit_t>   ej_in[2];
+
+  unsigned NODE_ID       = 0;
+  unsigned GEN_RATE      = 0;
+  unsigned PATTERN       = SYNTH_UNIFORM;
+  unsigned PKT_FLITS     = 4;
+  unsigned HOTSPOT       = 0;
+  unsigned HOTSPOT_RATE  = 0;
+  unsigned WARMUP_CYCLES = 0;
+  unsigned MEASURE_CYCLES = 0;
+
+  std::deque<flit_t> stored_flits[2];
+  
+  // Latency histogram of 1 cycle bins. The last bin gathers the longer latencies
+  static const unsigned LAT_BINS = 1024;
+
+  // Stats
+  unsigned long long int cycle;
+  unsigned long long int pkt_generated;
+  unsigned long long int pkt_ejected;
+  unsigned long long int flit_ejected;
+  unsigned long long int flit_ejected_measured;
+  unsigned long long int lat_count;
+  unsigned long long int lat_sum;
+  unsigned long long int lat_max;
+  unsigned long long int lat_hist[LAT_BINS];
+  int error_wrong_dst;
+
+  SC_HAS_PROCESS(synth_node);
+  synth_node(sc_module_name name_) : sc_module(name_)
+  {
+    SC_THREAD(do_cycle);
+    sensitive << clk.pos();
+    async_reset_signal_is(rst_n, false);
+  }
+
+  void do_cycle () {
+    cycle         = 0;
+    pkt_generated = 0;
+    pkt_ejected   = 0;
+    flit_ejected  = 0;
+    flit_ejected_measured = 0;
+    lat_count     = 0;
+    lat_sum       = 0;
+    lat_max       = 0;
+    for (unsigned b=0; b<LAT_BINS; ++b) lat_hist[b] = 0;
+    error_wrong_dst = 0;
+
+    for (int p=0; p<2; ++p) {
+      inj_out[p].Reset();
+      ej_in[p].Reset();
+    }
+
+    while(1) {
+      wait();
+      cycle++;
+
+      // Packet Generator
+      if (!stop_gen.read() && ((unsigned)(rand()%(100*PKT_FLITS)) < GEN_RATE)) gen_new_pkt();
+
+      for (int p=0; p<2; ++p) {
+        // Injection
+        if (!stored_flits[p].empty()) {
+          if (inj_out[p].PushNB(stored_flits[p].front())) stored_flits[p].pop_front();
+        }
+
+        // Ejection
+        flit_t rcv_flit;
+        if (ej_in[p].PopNB(rcv_flit)) {
+          flit_ejected++;
+          if ((cycle > WARMUP_CYCLES) && (cycle <= WARMUP_CYCLES+MEASURE_CYCLES)) flit_ejected_measured++;
+          if (rcv_flit.performs_rc() && (rcv_flit.get_dst() != NODE_ID)) {
+            std::cout << "[Node " << NODE_ID << "] ERROR: Flit to " << rcv_flit.get_dst() << " ejected here: " << rcv_flit << " @" << sc_time_stamp() << "\n";
+            error_wrong_dst++;
+          }
+          if (rcv_flit.is_tail() || rcv_flit.is_single()) {
+            pkt_ejected++;
+            unsigned long long int gen_cycle = rcv_flit.data[PHIT_NUM-1].to_uint();
+            if (gen_cycle > WARMUP_CYCLES) {
+              unsigned long long int lat = cycle - gen_cycle;
+              lat_count++;
+              lat_sum += lat;
+              if (lat > lat_max) lat_max = lat;
+              lat_hist[(lat < LAT_BINS-1) ? lat : LAT_BINS-1]++;
+            }
+          }
+        }
+      }
+    } // End of while(1)
+  };
+
+  unsigned gen_dst () {
+    unsigned x = NODE_ID % DIM_X;
+    unsigned y = NODE_ID / DIM_X;
+    if (PATTERN == SYNTH_TRANSPOSE) {
+      return (x*DIM_X + y);
+    } else if ((PATTERN == SYNTH_HOTSPOT) && ((unsigned)(rand()%100) < HOTSPOT_RATE)) {
+      return HOTSPOT;
+    } else {
+      return rand()%(DIM_X*DIM_Y);
+    }
+  };
+
+  void gen_new_pkt () {
+    unsigned dst = gen_dst();
+    if (dst == NODE_ID) return; // No self traffic
+
+    unsigned port = rand()%2;
+    for (unsigned f=0; f<PKT_FLITS; ++f) {
+      flit_t tmp_flit;
+      tmp_flit.type = (PKT_FLITS==1)     ? SINGLE :
+                      (f==0)             ? HEAD   :
+                      (f==PKT_FLITS-1)   ? TAIL   : BODY;
+      if (f==0) tmp_flit.set_network(NODE_ID, dst, 0, (port==0) ? dnp::PACK_TYPE__RD_REQ : dnp::PACK_TYPE__WR_REQ, 0);
+      else      tmp_flit.data[0] = rand();
+      tmp_flit.data[PHIT_NUM-1] = cycle;
+      stored_flits[port].push_back(tmp_flit);
+    }
+    pkt_generated++;
+  };
+}; // End of synth_node
+
+#endif // SYNTH_NODE_H
@@ -0,0 +1,159 @@
+#ifndef WGT_IC_HARNESS_H
+#define WGT_IC_HARNESS_H
+
+#include "systemc.h"
+
+#include <mc_scverify.h>
+
+#define NVHLS_VERIFY_BLOCKS (ic_top)
+
+#include "stdlib.h"
+#include <string>
+
+#include <iostream>
+
+// Packets of BENCH_PKT_FLITS flits. WEIGHTED_RR follows the weights with single flit packets only, as longer
+//   packets overshoot their share, while DEFICIT_RR follows them for any packet length
+#ifndef BENCH_PKT_FLITS
+  #define BENCH_PKT_FLITS 1
+#endif
+// The tolerated deviation from the weighted share of each input, in % of the output's flits
+#ifndef BENCH_TOL
+  #define BENCH_TOL 2
+#endif
+
+// Every input of the router injects back to back packets, thus the output is saturated and its flits
+//   are shared by the weights. The weights are held at the router's ports for the whole run, as a
+//   programmed configuration, and the flits of each input are counted at the output.
+SC_MODULE(harness) {
+  typedef ic_top::flit_t flit_t;
+
+  const int CLK_PERIOD     = 10;
+  const int WARMUP_CYCLES  = 1000;
+  const int MEASURE_CYCLES = 30 * 1000;
+
+  const unsigned WEIGHT[ic_top::IN_NUM] = {3, 2, 1};
+
+  sc_clock        clk;
+  sc_signal<bool> rst_n;
+
+  sc_signal< sc_uint<8> >  arb_weight[ic_top::IN_NUM];
+
+  CCS_DESIGN(ic_top) interconnect;
+
+  Connections::Out<flit_t>            inj_out[ic_top::IN_NUM];
+  Connections::In<flit_t>             ej_in;
+  Connections::Combinational<flit_t>  chan_inj[ic_top::IN_NUM];
+  Connections::Combinational<flit_t>  chan_ej;
+
+  // Stats
+  unsigned long long int cycle;
+  unsigned long long int flits_measured[ic_top::IN_NUM];
+
+  SC_CTOR(harness) :
+    clk("clock",10,SC_NS,0.5,0.0,SC_NS),
+    rst_n("rst_n"),
+
+    interconnect("interconnect")
+  {
+    std::cout << "---  Binding...  ---\n";
+    std::cout.flush();
+
+    interconnect.clk(clk);
+    interconnect.rst_n(rst_n);
+
+    for (unsigned ip=0; ip<ic_top::IN_NUM; ++ip) {
+      interconnect.arb_weight[ip](arb_weight[ip]);
+
+      inj_out[ip](chan_inj[ip]);
+      interconnect.inj_in[ip](chan_inj[ip]);
+    }
+    interconnect.ej_out(chan_ej);
+    ej_in(chan_ej);
+
+    std::cout << "---  Binding Succeed  ---\n";
+    std::cout.flush();
+
+    Connections::set_sim_clk(&clk);
+
+    SC_THREAD(harness_job);
+    sensitive << clk.posedge_event();
+  } // End of Constructor
+
+  void harness_job() {
+    std::cout << "--- Simulation is Starting @" << sc_time_stamp() << " ---\n";
+    std::cout.flush();
+    for (unsigned ip=0; ip<ic_top::IN_NUM; ++ip) {
+      arb_weight[ip].write(WEIGHT[ip]);
+      flits_measured[ip] = 0;
+      inj_out[ip].Reset();
+    }
+    ej_in.Reset();
+    cycle = 0;
+
+    rst_n.write(false);
+    wait(CLK_PERIOD*2, SC_NS);
+
+    rst_n.write(true);
+    wait(CLK_PERIOD*2, SC_NS);
+
+    // The next flit of each input's packet
+    unsigned flit_num[ic_top::IN_NUM];
+    for (unsigned ip=0; ip<ic_top::IN_NUM; ++ip) flit_num[ip] = 0;
+
+    while (cycle < (unsigned long long int)(WARMUP_CYCLES+MEASURE_CYCLES)) {
+      wait();
+      cycle++;
+
+      // Injection
+      for (unsigned ip=0; ip<ic_top::IN_NUM; ++ip) {
+        if (inj_out[ip].PushNB(gen_flit(ip, flit_num[ip]))) flit_num[ip] = (flit_num[ip]+1) % BENCH_PKT_FLITS;
+      }
+
+      // Ejection. Every flit carries the input it was injected to
+      flit_t rcv_flit;
+      if (ej_in.PopNB(rcv_flit) && (cycle > (unsigned long long int)WARMUP_CYCLES)) flits_measured[rcv_flit.get_src()]++;
+    }
+
+    //--- Stats ---//
+    unsigned long long int flits_total = 0;
+    unsigned weight_total = 0;
+    for (unsigned ip=0; ip<ic_top::IN_NUM; ++ip) {
+      flits_total  += flits_measured[ip];
+      weight_total += WEIGHT[ip];
+    }
+
+    int errors = 0;
+    for (unsigned ip=0; ip<ic_top::IN_NUM; ++ip) {
+      // The deviation of the input's flits from its weighted share, in % of the output's flits
+      long long int dev = (long long int)(flits_measured[ip]*weight_total) - (long long int)(flits_total*WEIGHT[ip]);
+      if (dev < 0) dev = -dev;
+      bool ok = (dev*100) <= (long long int)(flits_total*weight_total*BENCH_TOL);
+      if (!ok) errors++;
+
+      std::cout << (ok ? "" : "ERR : ") << "Input " << ip << " weight " << WEIGHT[ip] << "/" << weight_total
+                << " : " << flits_measured[ip] << " of " << flits_total << " flits\n";
+    }
+    std::cout << "Output throughput (flits/cycle): " << ((float)flits_total / (float)MEASURE_CYCLES) << "\n";
+    std::cout << "Errors (weighted share)        : " << errors << "\n";
+    // Single line summary, to be gathered by the check target of the example
+    std::cout << "BENCH arb=" << BENCH_ARB << " flits=" << BENCH_PKT_FLITS << " errors=" << errors << "\n";
+
+    std::cout << "\n Simulation Finished! \n";
+    std::cout.flush();
+    sc_assert(errors == 0);
+    sc_stop();
+  }
+
+  flit_t gen_flit (unsigned ip, unsigned f) {
+    flit_t tmp_flit;
+    tmp_flit.type = (BENCH_PKT_FLITS==1)   ? SINGLE :
+                    (f==0)                 ? HEAD   :
+                    (f==BENCH_PKT_FLITS-1) ? TAIL   : BODY;
+    tmp_flit.set_network(ip, 0, 0, dnp::PACK_TYPE__WR_REQ, 0);
+    tmp_flit.data[1] = cycle;
+    return tmp_flit;
+  };
+}; // End of harness
+
+#endif // WGT_IC_HARNESS_H
@@ -21,6 +21,8 @@ struct msg_tb_wrap {
   
   bool is_read = false;
   
+  bool cache_resp = false; // A memory side cache may respond instead of the Slave, thus OKAY rather than the Slave ID
+  
 	inline friend std::ostream& operator << ( std::ostream& os, const msg_tb_wrap& msg_tmp ) {
 		os << msg_tmp.dut_msg;
 		return os;